@@ -0,0 +1,153 @@
+#include "Benchmarks/Bench.hh"
+#include <atomic>
+#include <algorithm>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <map>
+#include <fstream>
+#include <iostream>
+#include <getopt.h>
+
+// count heap allocations by replacing the global operator new.  gcc mistakes the free of memory from the
+// replacement operator new for a mismatch
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+namespace {
+  std::atomic<size_t> nallocs_(0), nbytes_(0);
+}
+
+void* operator new(size_t size) {
+  nallocs_.fetch_add(1,std::memory_order_relaxed);
+  nbytes_.fetch_add(size,std::memory_order_relaxed);
+  if(void* mem = std::malloc(size > 0 ? size : 1)) return mem;
+  throw std::bad_alloc();
+}
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete(void* mem) noexcept { std::free(mem); }
+void operator delete[](void* mem) noexcept { operator delete(mem); }
+void operator delete(void* mem, size_t) noexcept { operator delete(mem); }
+void operator delete[](void* mem, size_t) noexcept { operator delete(mem); }
+// aligned allocation, used by the pmr new_delete_resource
+void* operator new(size_t size, std::align_val_t align) {
+  nallocs_.fetch_add(1,std::memory_order_relaxed);
+  nbytes_.fetch_add(size,std::memory_order_relaxed);
+  size_t alignment = std::max(static_cast<size_t>(align),sizeof(void*));
+  void* mem(0);
+  if(posix_memalign(&mem,alignment,size > 0 ? size : 1) == 0) return mem;
+  throw std::bad_alloc();
+}
+void* operator new[](size_t size, std::align_val_t align) { return operator new(size,align); }
+void operator delete(void* mem, std::align_val_t) noexcept { std::free(mem); }
+void operator delete[](void* mem, std::align_val_t) noexcept { std::free(mem); }
+void operator delete(void* mem, size_t, std::align_val_t) noexcept { std::free(mem); }
+void operator delete[](void* mem, size_t, std::align_val_t) noexcept { std::free(mem); }
+
+namespace KKBench {
+  size_t nAllocs() { return nallocs_.load(std::memory_order_relaxed); }
+  size_t allocBytes() { return nbytes_.load(std::memory_order_relaxed); }
+
+  Runner::Runner(int argc, char** argv, const char* name) : mintime_(0.2), tol_(0.2) {
+    static struct option long_options[] = {
+      {"filter",     required_argument, 0, 'f'  },
+      {"mintime",     required_argument, 0, 'm'  },
+      {"json",     required_argument, 0, 'j'  },
+      {"baseline",     required_argument, 0, 'b'  },
+      {"tolerance",     required_argument, 0, 't'  },
+      {NULL, 0,0,0}
+    };
+    int opt;
+    int long_index =0;
+    while ((opt = getopt_long_only(argc, argv,"",
+	    long_options, &long_index )) != -1) {
+      switch (opt) {
+	case 'f' : filter_ = std::string(optarg);
+		   break;
+	case 'm' : mintime_ = atof(optarg);
+		   break;
+	case 'j' : jsonfile_ = std::string(optarg);
+		   break;
+	case 'b' : basefile_ = std::string(optarg);
+		   break;
+	case 't' : tol_ = atof(optarg);
+		   break;
+	default: printf("Usage: %s --filter s --mintime f --json s --baseline s --tolerance f\n",name);
+		 exit(EXIT_FAILURE);
+      }
+    }
+  }
+
+  bool Runner::selected(std::string const& name) const {
+    return filter_.empty() || name.find(filter_) != std::string::npos;
+  }
+
+  void Runner::report(Result const& result) {
+    printf("%-48s %12.1f ns/op %10.2f allocs/op %12.0f bytes/op\n",result.name_.c_str(),result.nsPerOp_,
+	result.allocsPerOp_,result.bytesPerOp_);
+    fflush(stdout);
+    results_.push_back(result);
+  }
+
+  // read a value following the given key in a line of a results file
+  bool readValue(std::string const& line, const char* key, double& value) {
+    auto pos = line.find(key);
+    if(pos == std::string::npos)return false;
+    value = atof(line.c_str()+pos+strlen(key));
+    return true;
+  }
+
+  int Runner::finish() const {
+    if(!jsonfile_.empty()){
+      std::ofstream json(jsonfile_);
+      json.precision(8);
+      json << "{\n  \"benchmarks\": [\n";
+      for(size_t ires=0;ires<results_.size();ires++){
+	auto const& res = results_[ires];
+	// 1 benchmark per line: the baseline comparison relies on this
+	json << "    {\"name\": \"" << res.name_ << "\", \"ns_per_op\": " << res.nsPerOp_ << ", \"allocs_per_op\": " << res.allocsPerOp_
+	  << ", \"bytes_per_op\": " << res.bytesPerOp_ << ", \"iterations\": " << res.nops_ << "}"
+	  << (ires+1 < results_.size() ? ",\n" : "\n");
+      }
+      json << "  ]\n}\n";
+    }
+    int status(0);
+    if(!basefile_.empty()){
+      std::ifstream base(basefile_);
+      if(!base){
+	std::cout << "Can't open baseline " << basefile_ << std::endl;
+	return -1;
+      }
+      // read the baseline, written by a previous run with --json
+      std::map<std::string,Result> baseline;
+      std::string line;
+      const char* namekey = "\"name\": \"";
+      while(getline(base,line)){
+	auto pos = line.find(namekey);
+	if(pos == std::string::npos)continue;
+	pos += strlen(namekey);
+	Result res{line.substr(pos,line.find('"',pos)-pos),0.0,0.0,0.0,0};
+	if(readValue(line,"\"ns_per_op\": ",res.nsPerOp_) && readValue(line,"\"allocs_per_op\": ",res.allocsPerOp_))
+	  baseline[res.name_] = res;
+      }
+      printf("\n%-48s %12s %12s %8s %12s %12s\n","Comparison with baseline","base ns/op","ns/op","ratio","base allocs","allocs");
+      for(auto const& res : results_){
+	auto ibase = baseline.find(res.name_);
+	if(ibase == baseline.end()){
+	  printf("%-48s not in baseline\n",res.name_.c_str());
+	  continue;
+	}
+	auto const& bres = ibase->second;
+	double ratio = res.nsPerOp_/bres.nsPerOp_;
+	// allocation counts are deterministic up to the sampling of the inputs, so small changes are significant
+	bool slower = ratio > 1.0 + tol_;
+	bool moremem = res.allocsPerOp_ > bres.allocsPerOp_*(1.0 + 0.1*tol_) + 0.5;
+	printf("%-48s %12.1f %12.1f %8.3f %12.2f %12.2f%s%s\n",res.name_.c_str(),bres.nsPerOp_,res.nsPerOp_,ratio,
+	    bres.allocsPerOp_,res.allocsPerOp_, slower ? " SLOWER" : "", moremem ? " MORE ALLOCATIONS" : "");
+	if(slower || moremem) status = 1;
+      }
+    }
+    return status;
+  }
+}
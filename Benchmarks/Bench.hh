@@ -0,0 +1,67 @@
+#ifndef KinKal_Bench_hh
+#define KinKal_Bench_hh
+//
+//  Minimal benchmark driver.  A benchmark is a callable executing 1 operation.  It is run in growing batches until
+//  a minimum time has elapsed, and the time and heap allocations per operation are reported.  The results can be
+//  written as JSON, and compared with a baseline written by a previous run.
+//
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstddef>
+
+namespace KKBench {
+  // heap allocation counters, maintained by the global operator new replacement in Bench.cc
+  size_t nAllocs();
+  size_t allocBytes();
+
+  // prevent the compiler from optimizing away a result
+  template <class T> inline void keep(T const& value) { asm volatile("" : : "g"(&value) : "memory"); }
+
+  struct Result {
+    std::string name_;
+    double nsPerOp_; // wall time per operation (ns)
+    double allocsPerOp_, bytesPerOp_; // heap allocations per operation
+    size_t nops_; // number of operations timed
+  };
+
+  class Runner {
+    public:
+      // parse the command line.  Unknown options print the usage and exit
+      Runner(int argc, char** argv, const char* name);
+      // run a benchmark, unless it's excluded by the filter
+      template <class OP> void run(std::string const& name, OP&& op);
+      // is this benchmark selected?  Used to skip expensive setup
+      bool selected(std::string const& name) const;
+      // write the results and compare them with the baseline.  Returns non-zero if any benchmark regressed
+      int finish() const;
+      std::vector<Result> const& results() const { return results_; }
+    private:
+      void report(Result const& result);
+      std::string filter_; // substring of the benchmark names to run
+      std::string jsonfile_, basefile_; // JSON output and baseline input
+      double mintime_; // minimum time per benchmark (seconds)
+      double tol_; // fractional regression tolerance
+      std::vector<Result> results_;
+  };
+
+  template <class OP> void Runner::run(std::string const& name, OP&& op) {
+    if(!selected(name))return;
+    typedef std::chrono::steady_clock Clock;
+    op(); // warm up caches and lazy initialization
+    size_t nops(0), nbatch(1);
+    size_t allocs = nAllocs(), bytes = allocBytes();
+    double elapsed(0.0);
+    auto start = Clock::now();
+    do {
+      for(size_t iop=0;iop<nbatch;iop++) op();
+      nops += nbatch;
+      nbatch *= 2;
+      elapsed = std::chrono::duration<double>(Clock::now()-start).count();
+    } while(elapsed < mintime_);
+    allocs = nAllocs() - allocs;
+    bytes = allocBytes() - bytes;
+    report(Result{name, 1.0e9*elapsed/nops, double(allocs)/nops, double(bytes)/nops, nops});
+  }
+}
+#endif
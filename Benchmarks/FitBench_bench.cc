@@ -0,0 +1,92 @@
+//
+// macro benchmarks: complete KKTrk fits of ToyMC particles, for several numbers of hits and fit configurations.
+// Each operation constructs (and so fits) a KKTrk from one of a set of pre-simulated particles.
+//
+#include "Benchmarks/Bench.hh"
+#include "KinKal/LHelix.hh"
+#include "KinKal/KKTrk.hh"
+#include "KinKal/KKArena.hh"
+#include "UnitTests/ToyMC.hh"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstring>
+
+using namespace KinKal;
+using namespace std;
+
+template <class KTRAJ> void fitBench(KKBench::Runner& runner, std::string const& name, vector<MConfig> const& schedule,
+    unsigned nhits, bool addbf, bool arena, bool parallel=false, unsigned ntracks=20) {
+  typedef PKTraj<KTRAJ> PKTRAJ;
+  typedef KKTrk<KTRAJ> KKTRK;
+  typedef KKTest::ToyMC<KTRAJ> TOYMC;
+  if(!runner.selected(name))return;
+  double zrange(3000.0);
+  std::unique_ptr<BField> bfield;
+  if(addbf)
+    bfield = std::make_unique<GradBField>(0.95,1.05,-0.5*zrange,0.5*zrange);
+  else
+    bfield = std::make_unique<UniformBField>(1.0);
+  Vec3 bnom = bfield->fieldVect(Vec3(0.0,0.0,0.0));
+  TOYMC toy(*bfield, 105.0, -1, zrange, 123421, nhits, true, false, -1.0, 0.511);
+  toy.setSmearSeed(false);
+  auto config = make_shared<KKConfig>(*bfield);
+  config->maxniter_ = 10;
+  config->addbf_ = addbf;
+  config->schedule_ = schedule;
+  if(parallel) config->pool_ = std::make_shared<WorkStealingPool>();
+  // simulate the particles
+  struct Track {
+    KTRAJ seed_;
+    typename TOYMC::THITCOL thits_;
+    typename TOYMC::DXINGCOL dxings_;
+  };
+  vector<Track> tracks;
+  for(unsigned itrk=0;itrk<ntracks;itrk++){
+    PKTRAJ tptraj;
+    typename TOYMC::THITCOL thits;
+    typename TOYMC::DXINGCOL dxings;
+    toy.simulateParticle(tptraj,thits,dxings);
+    double tmid = tptraj.range().mid();
+    auto const& midhel = tptraj.nearestPiece(tmid);
+    KTRAJ seed(midhel.pos4(tmid),midhel.momentum(tmid),midhel.charge(),bnom,midhel.range());
+    toy.createSeed(seed);
+    tracks.push_back(Track{seed,thits,dxings});
+  }
+  KKArena kkarena;
+  size_t itrk(0);
+  runner.run(name,[&](){
+      auto& track = tracks[itrk++%tracks.size()];
+      kkarena.reset();
+      KKTRK kktrk(config,track.seed_,track.thits_,track.dxings_,arena ? &kkarena : std::pmr::get_default_resource());
+      KKBench::keep(kktrk.fitStatus()); });
+}
+
+int main(int argc, char **argv) {
+  KKBench::Runner runner(argc,argv,"FitBench");
+  // the standard iteration schedule
+  const char* source = std::getenv("PACKAGE_SOURCE");
+  if(source == 0){
+    cout << "PACKAGE_SOURCE not defined" << endl;
+    return -1;
+  }
+  vector<MConfig> schedule;
+  std::ifstream ifs(string(source) + "/UnitTests/Schedule.txt");
+  string line;
+  while (getline(ifs,line)){
+    if(strncmp(line.c_str(),"#",1)!=0){
+      istringstream ss(line);
+      schedule.push_back(MConfig(ss));
+    }
+  }
+  for(unsigned nhits : {20, 40, 80, 150})
+    fitBench<LHelix>(runner,"KKTrk<LHelix> fit, " + to_string(nhits) + " hits",schedule,nhits,false,false);
+  fitBench<LHelix>(runner,"KKTrk<LHelix> fit, 40 hits, arena",schedule,40,false,true);
+  fitBench<LHelix>(runner,"KKTrk<LHelix> fit, 80 hits, BField correction",schedule,80,true,false);
+  fitBench<LHelix>(runner,"KKTrk<LHelix> fit, 150 hits, parallel update",schedule,150,false,false,true);
+  return runner.finish();
+}
@@ -0,0 +1,139 @@
+//
+// microbenchmarks of the functions dominating the fit: trajectory evaluation, TPOCA, material effects, parameter
+// inversion, BField integration, and the Kalman sweeps over the fit effects
+//
+#include "Benchmarks/Bench.hh"
+#include "KinKal/LHelix.hh"
+#include "KinKal/PKTraj.hh"
+#include "KinKal/TLine.hh"
+#include "KinKal/TPoca.hh"
+#include "KinKal/TData.hh"
+#include "KinKal/BField.hh"
+#include "KinKal/StrawMat.hh"
+#include "KinKal/KKTrk.hh"
+#include "MatEnv/MatDBInfo.hh"
+#include "MatEnv/DetMaterial.hh"
+#include "UnitTests/ToyMC.hh"
+
+#include <vector>
+#include <random>
+#include <cmath>
+#include <memory>
+#include <sstream>
+#include <type_traits>
+
+using namespace KinKal;
+using namespace std;
+
+// forward and backward sweeps over the effects of a converged fit, stored by value in the fit's time-ordered variant
+// container, and as the pointers to the KKEff base used before, with virtual dispatch
+template <class KTRAJ, class THITCOL, class DXINGCOL> void sweepBench(KKBench::Runner& runner, std::string const& name,
+    BField const& bfield, KTRAJ const& seed, THITCOL thits, DXINGCOL dxings, bool addmat) {
+  typedef KKTrk<KTRAJ> KKTRK;
+  auto config = make_shared<KKConfig>(bfield);
+  config->addmat_ = config->addbf_ = addmat;
+  istringstream sconfig("1 1 0 0.0 0.01 10.0 1.0");
+  config->schedule_.push_back(MConfig(sconfig));
+  KKTRK kktrk(config,seed,thits,dxings);
+  typename KKTRK::KKEFFCOL veffects(kktrk.effects());
+  vector<unique_ptr<typename KKTRK::KKEFF>> peffects;
+  for(auto const& effv : veffects)
+    std::visit([&peffects](auto const& eff) { peffects.push_back(make_unique<std::decay_t<decltype(eff)>>(eff)); }, effv);
+  runner.run(name + ", variant",[&](){
+      KKData<KTRAJ::NParams()> fdata, bdata;
+      double chisq(0.0);
+      for(auto& effv : veffects)
+	std::visit([&](auto& eff) { chisq += eff.chisq(fdata.pData()); eff.process(fdata,TDir::forwards); }, effv);
+      for(auto ieff = veffects.rbegin(); ieff != veffects.rend(); ieff++)
+	std::visit([&bdata](auto& eff) { eff.process(bdata,TDir::backwards); }, *ieff);
+      KKBench::keep(chisq);
+      KKBench::keep(bdata); });
+  runner.run(name + ", unique_ptr<KKEff>",[&](){
+      KKData<KTRAJ::NParams()> fdata, bdata;
+      double chisq(0.0);
+      for(auto& eff : peffects) {
+	chisq += eff->chisq(fdata.pData());
+	eff->process(fdata,TDir::forwards);
+      }
+      for(auto ieff = peffects.rbegin(); ieff != peffects.rend(); ieff++)
+	(*ieff)->process(bdata,TDir::backwards);
+      KKBench::keep(chisq);
+      KKBench::keep(bdata); });
+}
+
+int main(int argc, char **argv) {
+  typedef LHelix KTRAJ;
+  typedef PKTraj<KTRAJ> PKTRAJ;
+  typedef KKTest::ToyMC<KTRAJ> TOYMC;
+  KKBench::Runner runner(argc,argv,"MicroBench");
+  // simulate a particle with material and a BField gradient, and straws along it
+  double zrange(3000.0);
+  GradBField bfield(0.95,1.05,-0.5*zrange,0.5*zrange);
+  TOYMC toy(bfield, 105.0, -1, zrange, 123421, 50, true, false, -1.0, 0.511);
+  PKTRAJ pktraj;
+  TOYMC::THITCOL thits;
+  TOYMC::DXINGCOL dxings;
+  toy.simulateParticle(pktraj,thits,dxings);
+  // inputs are cycled through, from tables small enough to stay in cache
+  static const size_t ninput(1024), imask(ninput-1);
+  std::mt19937 rng(12345);
+  std::uniform_real_distribution<double> unit(0.0,1.0);
+  auto const& helix = pktraj.nearestPiece(pktraj.range().mid());
+  vector<double> htimes, ptimes;
+  vector<TLine> straws;
+  for(size_t ii=0;ii<ninput;ii++){
+    htimes.push_back(helix.range().low() + unit(rng)*helix.range().range());
+    ptimes.push_back(pktraj.range().low() + unit(rng)*pktraj.range().range());
+    if(straws.size() < 64) straws.push_back(toy.generateStraw(pktraj,ptimes.back()));
+  }
+  size_t iin(0);
+  runner.run("LHelix::position",[&](){ KKBench::keep(helix.position(htimes[++iin&imask])); });
+  runner.run("LHelix::direction",[&](){ KKBench::keep(helix.direction(htimes[++iin&imask])); });
+  runner.run("LHelix::momDeriv",[&](){ KKBench::keep(helix.momDeriv(htimes[++iin&imask],LocalBasis::perpdir)); });
+  // POCA to straws crossed by the particle, using the piece nearest each straw for the single-helix case
+  vector<KTRAJ const*> spieces;
+  for(auto const& straw : straws) spieces.push_back(&pktraj.nearestPiece(straw.range().mid()));
+  runner.run("TPoca<LHelix,TLine>",[&](){ ++iin;
+      TPoca<KTRAJ,TLine> tpoca(*spieces[iin%straws.size()],straws[iin%straws.size()]);
+      KKBench::keep(tpoca.doca()); });
+  runner.run("TPoca<PKTraj<LHelix>,TLine>",[&](){ ++iin;
+      TPoca<PKTRAJ,TLine> tpoca(pktraj,straws[iin%straws.size()]);
+      KKBench::keep(tpoca.doca()); });
+  // material effects, analytic and tabulated
+  vector<double> moms;
+  for(size_t ii=0;ii<ninput;ii++) moms.push_back(exp(log(10.0) + unit(rng)*log(100.0)));
+  MatEnv::MatDBInfo matdb, tabmatdb;
+  tabmatdb.tabulate({0.511});
+  auto gas = matdb.findDetMaterial("straw-gas");
+  auto tabgas = tabmatdb.findDetMaterial("straw-gas");
+  runner.run("DetMaterial::dEdx",[&](){ KKBench::keep(gas->dEdx(moms[++iin&imask],gas->elossType(),0.511)); });
+  runner.run("DetMaterial::dEdx, tabulated",[&](){ KKBench::keep(tabgas->dEdx(moms[++iin&imask],tabgas->elossType(),0.511)); });
+  runner.run("DetMaterial::scatterAngleRMS",[&](){ KKBench::keep(gas->scatterAngleRMS(moms[++iin&imask],4.0,0.511)); });
+  // straw material crossings
+  StrawMat const& smat = toy.strawMaterial();
+  vector<array<double,3>> sxings;
+  for(size_t ii=0;ii<ninput;ii++) sxings.push_back({(2.0*unit(rng)-1.0)*smat.strawRadius(),unit(rng)*smat.strawRadius(),0.9*(2.0*unit(rng)-1.0)});
+  MatXingCol mxings;
+  runner.run("StrawMat::findXings",[&](){ auto const& sx = sxings[++iin&imask];
+      smat.findXings(sx[0],sx[1],sx[2],mxings);
+      KKBench::keep(mxings); });
+  // parameter <-> weight inversion, using the covariance of a fit seed
+  KTRAJ seed(helix);
+  toy.createSeed(seed);
+  auto const& params = seed.params();
+  runner.run("TData::invert",[&](){ TData<KTRAJ::NParams()> tdata(params.tData()); tdata.invert(); KKBench::keep(tdata); });
+  // BField correction integral over a piece of the trajectory
+  vector<TRange> ranges;
+  for(size_t ii=0;ii<ninput;ii++){
+    double tstart = pktraj.range().low() + unit(rng)*0.8*pktraj.range().range();
+    ranges.push_back(TRange(tstart,tstart+0.1*pktraj.range().range()));
+  }
+  runner.run("BField::integrate",[&](){ auto const& range = ranges[++iin&imask];
+      Vec3 dmom;
+      KKBench::keep(bfield.integrate(pktraj.nearestPiece(range.mid()),range,dmom));
+      KKBench::keep(dmom); });
+  // sweeps over the effects of a converged fit, with all the effects and with hits only
+  sweepBench<KTRAJ>(runner,"KKTrk sweeps",bfield,seed,thits,dxings,true);
+  sweepBench<KTRAJ>(runner,"KKTrk sweeps, hits only",bfield,seed,thits,dxings,false);
+  return runner.finish();
+}
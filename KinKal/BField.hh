@@ -3,9 +3,11 @@
 // class defining a BField Map interface for use in KinKal.
 #include "KinKal/Vectors.hh"
 #include "KinKal/TRange.hh"
+#include "KinKal/FitStats.hh"
 #include "CLHEP/Units/PhysicalConstants.h"
 #include "Math/SMatrix.h"
 #include <vector>
+#include <array>
 #include <algorithm>
 #include <cstdarg>
 
@@ -19,14 +21,27 @@ namespace KinKal {
       virtual Grad fieldGrad(Vec3 const& position) const = 0;
       // return the BField derivative at a given point along a given velocity, WRT time
       virtual Vec3 fieldDeriv(Vec3 const& position, Vec3 const& velocity) const = 0;
+      // value of the field at a point along a trajectory, labeled by the trajectory time.  The time is ignored here;
+      // BFieldCache uses it to share samples between the domain finding and the integration
+      virtual Vec3 sampleField(double time, Vec3 const& position) const { KKSTAT_COUNT(nbfield_,1); return fieldVect(position); }
       // integrate the magentic force over the given trajectory and range, due to the DIFFERENCE
       // between this field and the field vector referenced by the traj.  Returns the change in momentum
-      // ( = - integral of the 'external' force needed to keep the particle onto this trajectory);
-      template <class KTRAJ> void integrate(KTRAJ const& ktraj, TRange const& range, Vec3& dmom) const;
+      // ( = - integral of the 'external' force needed to keep the particle onto this trajectory).
+      // The integration is adaptive: intervals are subdivided until the estimated error on the momentum change is below
+      // tol (MeV/c), so field lookups are concentrated where the field varies.  Returns the number of field evaluations
+      template <class KTRAJ> unsigned integrate(KTRAJ const& ktraj, TRange const& range, Vec3& dmom, double tol=1.0e-4) const;
       // speed of light in units to convert Tesla to mm (bending radius)
       static double cbar() { static double retval = CLHEP::c_light/1000.0; return retval; }
 
       virtual ~BField(){}
+    private:
+      // force due to the field difference at a given time
+      template <class KTRAJ> Vec3 dForce(KTRAJ const& ktraj, double time) const {
+	return cbar()*ktraj.charge()*ktraj.velocity(time).Cross(sampleField(time,ktraj.position(time)) - ktraj.bnom(time)); }
+      // recursive adaptive Simpson's rule integration of the force, given the values at the ends and middle of the range
+      template <class KTRAJ> Vec3 integrate(KTRAJ const& ktraj, TRange const& range, std::array<Vec3,3> const& force,
+	  Vec3 const& whole, double tol, unsigned depth, unsigned& neval) const;
+      static const unsigned maxdepth_ = 8; // maximum number of interval subdivisions
   };
 
   // trivial instance of the above, used for testing
@@ -71,25 +86,42 @@ namespace KinKal {
       Grad fgrad_;
   };
 
-  template<class KTRAJ> void BField::integrate(KTRAJ const& ktraj, TRange const& trange, Vec3& dmom) const {
+  template<class KTRAJ> unsigned BField::integrate(KTRAJ const& ktraj, TRange const& trange, Vec3& dmom, double tol) const {
     dmom = Vec3();
-    // compare this field with the noiminal at a few points. only bother to integrate if this is outside tolerance.
-    std::vector<double> tvals = {trange.low(),trange.mid(),trange.high()};
-    std::vector<double> db;
-    for(auto tval :tvals){
-      Vec3 bf = fieldVect(ktraj.position(tval));
-      db.push_back( (bf - ktraj.bnom(tval)).R());
+    // compare this field with the noiminal at the ends and middle. only bother to integrate if this is outside tolerance.
+    std::array<double,3> tvals = {trange.low(),trange.mid(),trange.high()};
+    std::array<double,3> db;
+    std::array<Vec3,3> force;
+    for(size_t ival=0;ival<tvals.size();ival++){
+      Vec3 bf = sampleField(tvals[ival],ktraj.position(tvals[ival]));
+      Vec3 dbf = bf - ktraj.bnom(tvals[ival]);
+      db[ival] = dbf.R();
+      force[ival] = cbar()*ktraj.charge()*ktraj.velocity(tvals[ival]).Cross(dbf);
     }
+    unsigned neval(tvals.size());
     if(*std::max_element(db.begin(),db.end()) > 1e-6){ // tolerance should be a parameter FIXME!
-      unsigned nsteps(10); // this should be computed from field rate-of-change over this range FIXME!
-      double dt = trange.range()/double(nsteps);
-      for(unsigned istep=0; istep< nsteps; istep++){
-	double tstep = trange.low() + istep*dt;
-	Vec3 vel = ktraj.velocity(tstep);
-	Vec3 db = fieldVect(ktraj.position(tstep)) - ktraj.bnom(tstep);
-	dmom += cbar()*ktraj.charge()*dt*vel.Cross(db);
-      }
+      // the same points are the starting Simpson's rule estimate
+      Vec3 whole = (trange.range()/6.0)*(force[0] + 4.0*force[1] + force[2]);
+      dmom = integrate(ktraj,trange,force,whole,tol,maxdepth_,neval);
     }
+    return neval;
+  }
+
+  template<class KTRAJ> Vec3 BField::integrate(KTRAJ const& ktraj, TRange const& trange, std::array<Vec3,3> const& force,
+      Vec3 const& whole, double tol, unsigned depth, unsigned& neval) const {
+    // split the range in 2, and compare the sum of the halves with the whole
+    TRange lrange(trange.low(),trange.mid()), hrange(trange.mid(),trange.high());
+    std::array<Vec3,3> lforce = {force[0], dForce(ktraj,lrange.mid()), force[1]};
+    std::array<Vec3,3> hforce = {force[1], dForce(ktraj,hrange.mid()), force[2]};
+    neval += 2;
+    Vec3 lint = (lrange.range()/6.0)*(lforce[0] + 4.0*lforce[1] + lforce[2]);
+    Vec3 hint = (hrange.range()/6.0)*(hforce[0] + 4.0*hforce[1] + hforce[2]);
+    Vec3 delta = lint + hint - whole;
+    // the error on the sum is ~1/15 of the difference, which is also used as a (Richardson) correction
+    if(depth == 0 || delta.R() < 15.0*tol)
+      return lint + hint + delta/15.0;
+    else
+      return integrate(ktraj,lrange,lforce,lint,0.5*tol,depth-1,neval) + integrate(ktraj,hrange,hforce,hint,0.5*tol,depth-1,neval);
   }
 
 }
@@ -0,0 +1,22 @@
+#include "KinKal/BFieldCache.hh"
+#include "KinKal/FitStats.hh"
+
+namespace KinKal {
+  Vec3 BFieldCache::sampleField(double time, Vec3 const& position) const {
+    ++nlookup_;
+    auto ifnd = samples_.lower_bound(time);
+    if(ifnd != samples_.end() && ifnd->first == time){
+      Sample& sample = ifnd->second;
+      if((sample.pos_ - position).Mag2() < dxtol_*dxtol_) return sample.bvec_;
+      // the trajectory has moved: update the sample in place
+      ++neval_;
+      KKSTAT_COUNT(nbfield_,1);
+      sample.pos_ = position;
+      sample.bvec_ = bfield_.fieldVect(position);
+      return sample.bvec_;
+    }
+    ++neval_;
+    KKSTAT_COUNT(nbfield_,1);
+    return samples_.emplace_hint(ifnd,time,Sample{position,bfield_.fieldVect(position)})->second.bvec_;
+  }
+}
@@ -0,0 +1,46 @@
+#ifndef KinKal_BFieldCache_hh
+#define KinKal_BFieldCache_hh
+//
+//  Cache of BField samples along a single trajectory, keyed by the trajectory time.  The domain finding
+//  (rangeInTolerance) and the domain integration (integrate) sample the field at the same times, so they share the
+//  samples.  A sample is reused as long as the trajectory position at that time has moved less than a tolerance since
+//  the field was evaluated, so the samples survive fit iterations which change the reference trajectory by a small amount.
+//  The cache is not thread-safe: it should be owned by a single fit (track).
+//
+#include "KinKal/BField.hh"
+#include <map>
+#include <memory_resource>
+
+namespace KinKal {
+  class BFieldCache : public BField {
+    public:
+      // wrap the given field.  Samples are reused if the position has changed by less than dxtol (mm)
+      BFieldCache(BField const& bfield, double dxtol, std::pmr::memory_resource* mres=std::pmr::get_default_resource()) :
+	bfield_(bfield), dxtol_(dxtol), samples_(mres), nlookup_(0), neval_(0) {}
+      virtual ~BFieldCache() {}
+      BFieldCache(BFieldCache const& ) = delete;
+      BFieldCache& operator =(BFieldCache const& ) = delete;
+      // position-only access goes directly to the wrapped field
+      virtual Vec3 fieldVect(Vec3 const& position) const override { return bfield_.fieldVect(position); }
+      virtual Grad fieldGrad(Vec3 const& position) const override { return bfield_.fieldGrad(position); }
+      virtual Vec3 fieldDeriv(Vec3 const& position, Vec3 const& velocity) const override { return bfield_.fieldDeriv(position,velocity); }
+      virtual Vec3 sampleField(double time, Vec3 const& position) const override;
+      // accessors
+      BField const& bfield() const { return bfield_; }
+      double tolerance() const { return dxtol_; }
+      size_t nSamples() const { return samples_.size(); }
+      unsigned nLookups() const { return nlookup_; } // number of sample requests
+      unsigned nEvals() const { return neval_; } // number of those which evaluated the wrapped field
+      void clear() { samples_.clear(); }
+    private:
+      struct Sample {
+	Vec3 pos_; // position where the field was evaluated
+	Vec3 bvec_; // field value
+      };
+      BField const& bfield_; // wrapped field
+      double dxtol_; // position tolerance for reusing a sample
+      mutable std::pmr::map<double,Sample> samples_; // samples, keyed by time
+      mutable unsigned nlookup_, neval_;
+  };
+}
+#endif
@@ -7,6 +7,8 @@
 #include "KinKal/LocalBasis.hh"
 #include "KinKal/MatXing.hh"
 #include "KinKal/TDir.hh"
+#include "KinKal/TPocaBase.hh"
+#include "KinKal/FitStats.hh"
 #include <vector>
 #include <stdexcept>
 #include <array>
@@ -22,24 +24,26 @@ namespace KinKal {
       virtual ~DXing() {}
       virtual void update(PKTRAJ const& pktraj) =0;
       virtual void update(PKTRAJ const& pktraj, double xtime) =0; // update including an estimate of the xing time
+      virtual void update(TPocaBase const& tpoca) =0; // update from an existing TPOCA between the trajectory and the sensor
       virtual void print(std::ostream& ost=std::cout,int detail=0) const =0;
       // accessors
       double crossingTime() const { return xtime_; }
       double& crossingTime() { return xtime_; }
-      std::vector<MatXing>const&  matXings() const { return mxings_; }
-      // calculate the cumulative material effect from these crossings
-      void momEffects(PKTRAJ const& pktraj, TDir tdir, std::array<double,3>& dmom, std::array<double,3>& momvar) const;
+      MatXingCol const&  matXings() const { return mxings_; }
+      // calculate the cumulative material effect from these crossings, on either a piecewise or a single trajectory
+      template <class TRAJ> void momEffects(TRAJ const& traj, TDir tdir, std::array<double,3>& dmom, std::array<double,3>& momvar) const;
     protected:
       double xtime_; // time on the reference trajectory when the xing occured
-      std::vector<MatXing> mxings_; // material crossings for this detector piece on this trajectory
+      MatXingCol mxings_; // material crossings for this detector piece on this trajectory
   };
 
-  template <class KTRAJ> void DXing<KTRAJ>::momEffects(PKTRAJ const& pktraj, TDir tdir, std::array<double,3>& dmom, std::array<double,3>& momvar) const {
+  template <class KTRAJ> template <class TRAJ> void DXing<KTRAJ>::momEffects(TRAJ const& traj, TDir tdir, std::array<double,3>& dmom, std::array<double,3>& momvar) const {
     // compute the derivative of momentum to energy
-    double mom = pktraj.momentumMag(xtime_);
-    double mass = pktraj.mass();
+    double mom = traj.momentumMag(xtime_);
+    double mass = traj.mass();
     double dmFdE = sqrt(mom*mom+mass*mass)/(mom*mom); // dimension of 1/E
     if(tdir == TDir::backwards)dmFdE *= -1.0;
+    KKSTAT_COUNT(nmat_,mxings_.size());
     // loop over crossings for this detector piece
     for(auto const& mxing : mxings_){
       // compute FRACTIONAL momentum change and variance on that in the given direction
@@ -0,0 +1,41 @@
+#include "KinKal/FitStats.hh"
+namespace KinKal {
+
+  FitStats& FitStats::operator +=(FitStats const& other) {
+    npoca_ += other.npoca_;
+    npocaiter_ += other.npocaiter_;
+    ninvert_ += other.ninvert_;
+    nbfield_ += other.nbfield_;
+    nmat_ += other.nmat_;
+    tupdate_ += other.tupdate_;
+    tforward_ += other.tforward_;
+    tbackward_ += other.tbackward_;
+    tappend_ += other.tappend_;
+    return *this;
+  }
+
+  FitStats& FitStats::operator -=(FitStats const& other) {
+    npoca_ -= other.npoca_;
+    npocaiter_ -= other.npocaiter_;
+    ninvert_ -= other.ninvert_;
+    nbfield_ -= other.nbfield_;
+    nmat_ -= other.nmat_;
+    tupdate_ -= other.tupdate_;
+    tforward_ -= other.tforward_;
+    tbackward_ -= other.tbackward_;
+    tappend_ -= other.tappend_;
+    return *this;
+  }
+
+  std::ostream& operator <<(std::ostream& ost, FitStats const& stats) {
+    ost << "TPOCA " << stats.npoca_ << " (" << stats.npocaiter_ << " iterations)"
+      << " inversions " << stats.ninvert_
+      << " BField " << stats.nbfield_
+      << " material " << stats.nmat_
+      << " time (us) update " << stats.tupdate_*1.0e6
+      << " forward " << stats.tforward_*1.0e6
+      << " backward " << stats.tbackward_*1.0e6
+      << " append " << stats.tappend_*1.0e6;
+    return ost;
+  }
+}
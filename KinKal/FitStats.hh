@@ -0,0 +1,50 @@
+#ifndef KinKal_FitStats_hh
+#define KinKal_FitStats_hh
+//
+//  Optional fit instrumentation: counts of the expensive operations, and the time spent in each phase of a fit iteration.
+//  The counters are only compiled in when KINKAL_FITSTATS is defined; otherwise the KKSTAT macros expand to nothing, and
+//  FitStatus carries no statistics.  Counts accumulate in running totals for each thread, which KKTrk differences
+//  around each iteration.
+//
+#include <chrono>
+#include <ostream>
+
+namespace KinKal {
+  struct FitStats {
+    unsigned npoca_ = 0; // TPOCA solutions
+    unsigned npocaiter_ = 0; // iterations of those solutions
+    unsigned ninvert_ = 0; // parameter <-> weight inversions in KKData
+    unsigned nbfield_ = 0; // BField evaluations (value or time derivative)
+    unsigned nmat_ = 0; // material crossing (energy loss and scattering) evaluations
+    double tupdate_ = 0.0, tforward_ = 0.0, tbackward_ = 0.0, tappend_ = 0.0; // time in each phase of the iteration (seconds)
+    FitStats& operator +=(FitStats const& other);
+    FitStats& operator -=(FitStats const& other);
+    // running totals for the calling thread
+    static FitStats& threadTotals() { static thread_local FitStats totals; return totals; }
+    // add the time since construction or the last lap to the given phase of the thread totals
+    class Timer {
+      public:
+	Timer() : start_(std::chrono::steady_clock::now()) {}
+	void lap(double FitStats::*phase) {
+	  auto now = std::chrono::steady_clock::now();
+	  threadTotals().*phase += std::chrono::duration<double>(now-start_).count();
+	  start_ = now;
+	}
+      private:
+	std::chrono::steady_clock::time_point start_;
+    };
+  };
+  inline FitStats operator -(FitStats stats, FitStats const& other) { return stats -= other; }
+  std::ostream& operator <<(std::ostream& os, FitStats const& stats);
+}
+
+#ifdef KINKAL_FITSTATS
+#define KKSTAT_COUNT(counter,n) (KinKal::FitStats::threadTotals().counter += (n))
+#define KKSTAT_TIMER(timer) KinKal::FitStats::Timer timer
+#define KKSTAT_LAP(timer,phase) timer.lap(&KinKal::FitStats::phase)
+#else
+#define KKSTAT_COUNT(counter,n) ((void)0)
+#define KKSTAT_TIMER(timer) ((void)0)
+#define KKSTAT_LAP(timer,phase) ((void)0)
+#endif
+#endif
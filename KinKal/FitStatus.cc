@@ -28,6 +28,9 @@ namespace KinKal {
       << " chisq " << fitstatus.chisq_ 
       << " NDOF " << fitstatus.ndof_
       << " prob " << fitstatus.prob_;
+#ifdef KINKAL_FITSTATS
+    ost << " stats " << fitstatus.stats_;
+#endif
     return ost;
   }
 }
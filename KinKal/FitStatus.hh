@@ -1,5 +1,6 @@
 #ifndef KinKal_FitStatus_hh
 #define KinKal_FitStatus_hh
+#include "KinKal/FitStats.hh"
 #include <ostream>
 #include <string>
 #include <vector>
@@ -16,6 +17,10 @@ namespace KinKal {
     unsigned ndof_; // current number of degrees of freedom
     double prob_; // chisquared probability
     std::string comment_; // further information about the status 
+#ifdef KINKAL_FITSTATS
+    FitStats stats_; // cost of this iteration
+    FitStats mstats_; // cumulative cost of this meta-iteration, through this iteration
+#endif
     bool usable() const { return status_ !=failed; }
     bool needsFit() const { return status_ == needsfit || status_ == unconverged; }
     FitStatus(unsigned miter) : miter_(miter), iter_(-1), status_(needsfit), chisq_(std::numeric_limits<double>::max()), ndof_(0), prob_(-1.0){}
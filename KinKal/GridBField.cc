@@ -0,0 +1,321 @@
+#include "KinKal/GridBField.hh"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace KinKal {
+  namespace {
+    const char gridmagic[8] = "KKBGRID";
+    const char rzgridmagic[8] = "KKBRZGR";
+    const uint32_t gridversion = 1;
+
+    // map a binary grid file and check the header is consistent with it.  Unused dimensions have 1 point
+    GridBField::Header const* mapGrid(std::string const& filename, char const* magic, unsigned ncomp, void*& map, size_t& mapsize) {
+      map = MAP_FAILED;
+      mapsize = 0;
+      int fd = open(filename.c_str(),O_RDONLY);
+      if(fd < 0) throw std::runtime_error("Can't open BField grid file " + filename);
+      struct stat fstats;
+      if(fstat(fd,&fstats) == 0 && size_t(fstats.st_size) >= sizeof(GridBField::Header)){
+	mapsize = fstats.st_size;
+	map = mmap(0,mapsize,PROT_READ,MAP_SHARED,fd,0);
+      }
+      close(fd); // the mapping stays valid
+      if(map == MAP_FAILED) throw std::runtime_error("Can't map BField grid file " + filename);
+      auto header = static_cast<GridBField::Header const*>(map);
+      std::string error;
+      size_t npoints(1);
+      for(size_t idim=0; idim < 3; idim++){
+	npoints *= header->npts_[idim];
+	if(header->npts_[idim] < 1 || header->spacing_[idim] <= 0.0) error = "Invalid BField grid in ";
+      }
+      if(strncmp(header->magic_,magic,sizeof(gridmagic)) != 0 || header->version_ != gridversion)
+	error = "Invalid BField grid file ";
+      else if(error.empty() && mapsize != sizeof(GridBField::Header) + ncomp*sizeof(float)*npoints)
+	error = "Truncated BField grid file ";
+      if(!error.empty()){
+	munmap(map,mapsize);
+	throw std::runtime_error(error + filename);
+      }
+      return header;
+    }
+
+    // interpolation points along 1 grid axis, with their weights and the derivatives of the weights.  Points
+    // beyond the edges are replaced by the edge point, or optionally mirrored about the 1st point (the r=0 axis)
+    unsigned axisWeights(double pos, unsigned npts, double origin, double spacing, bool cubic, bool mirror,
+	std::array<size_t,4>& index, std::array<double,4>& wt, std::array<double,4>& dwt, std::array<bool,4>& flip) {
+      int ipts = npts;
+      double du = 1.0/spacing;
+      double upos = std::min(std::max((pos-origin)*du,0.0),double(ipts-1));
+      int ipt = std::min(int(upos),ipts-2);
+      double t = upos - ipt;
+      if(cubic){
+	// Catmull-Rom weights for points ipt-1 to ipt+2
+	for(int iw=0;iw<4;iw++){
+	  int jpt = ipt+iw-1;
+	  flip[iw] = mirror && jpt < 0;
+	  index[iw] = flip[iw] ? -jpt : std::min(std::max(jpt,0),ipts-1);
+	}
+	double t2 = t*t, t3 = t2*t;
+	wt = {0.5*(-t3 + 2.0*t2 - t), 0.5*(3.0*t3 - 5.0*t2 + 2.0), 0.5*(-3.0*t3 + 4.0*t2 + t), 0.5*(t3 - t2)};
+	dwt = {0.5*du*(-3.0*t2 + 4.0*t - 1.0), 0.5*du*(9.0*t2 - 10.0*t), 0.5*du*(-9.0*t2 + 8.0*t + 1.0), 0.5*du*(3.0*t2 - 2.0*t)};
+	return 4;
+      } else {
+	index[0] = ipt; index[1] = ipt+1;
+	wt[0] = 1.0-t; wt[1] = t;
+	dwt[0] = -du; dwt[1] = du;
+	flip[0] = flip[1] = false;
+	return 2;
+      }
+    }
+
+    // convert an ASCII dump with 'ncoord' coordinate columns followed by the same number of field columns.  The
+    // coordinates are assigned to the given header dimensions
+    size_t convertGrid(std::string const& asciifile, std::string const& binaryfile, char const* magic, std::vector<size_t> const& dims) {
+      std::ifstream ascii(asciifile);
+      if(!ascii) throw std::runtime_error("Can't open BField grid dump " + asciifile);
+      // read all the points
+      size_t ncol = 2*dims.size();
+      std::vector<double> points;
+      std::string line;
+      while(std::getline(ascii,line)){
+	size_t ifirst = line.find_first_not_of(" \t\r");
+	if(ifirst == std::string::npos || line[ifirst] == '#')continue;
+	std::istringstream sline(line);
+	for(size_t icol=0; icol < ncol; icol++){
+	  double val;
+	  sline >> val;
+	  points.push_back(val);
+	}
+	if(sline.fail()) throw std::runtime_error("Invalid BField grid line: " + line);
+      }
+      size_t npoints = points.size()/ncol;
+      // deduce the grid from the range of coordinates and the number of distinct values on each axis
+      GridBField::Header header;
+      memset(&header,0,sizeof(header));
+      memcpy(header.magic_,magic,sizeof(header.magic_));
+      header.version_ = gridversion;
+      for(size_t idim=0; idim < 3; idim++){
+	header.npts_[idim] = 1;
+	header.spacing_[idim] = 1.0;
+      }
+      for(size_t icoord=0; icoord < dims.size(); icoord++){
+	std::vector<double> vals;
+	vals.reserve(npoints);
+	for(size_t ipt=0; ipt < npoints; ipt++) vals.push_back(points[ipt*ncol+icoord]);
+	std::sort(vals.begin(),vals.end());
+	if(vals.empty() || vals.back() <= vals.front()) throw std::runtime_error("Degenerate BField grid in " + asciifile);
+	double vmin = vals.front(), vmax = vals.back();
+	double tol = 1.0e-6*(vmax-vmin);
+	size_t nvals = std::unique(vals.begin(),vals.end(),[tol](double a, double b){ return b-a < tol; }) - vals.begin();
+	size_t idim = dims[icoord];
+	header.npts_[idim] = nvals;
+	header.origin_[idim] = vmin;
+	header.spacing_[idim] = (vmax-vmin)/(nvals-1);
+      }
+      // fill the grid, checking each point is on it and is only given once
+      std::vector<float> data(dims.size()*header.npts_[0]*header.npts_[1]*header.npts_[2],std::numeric_limits<float>::quiet_NaN());
+      for(size_t ipt=0; ipt < npoints; ipt++){
+	double const* point = points.data() + ipt*ncol;
+	size_t igrid[3] = {0,0,0};
+	for(size_t icoord=0; icoord < dims.size(); icoord++){
+	  size_t idim = dims[icoord];
+	  double upos = (point[icoord]-header.origin_[idim])/header.spacing_[idim];
+	  igrid[idim] = size_t(std::rint(upos));
+	  if(fabs(upos - igrid[idim]) > 1.0e-3) throw std::runtime_error("Irregular BField grid in " + asciifile);
+	}
+	float* bval = data.data() + dims.size()*((igrid[0]*header.npts_[1] + igrid[1])*header.npts_[2] + igrid[2]);
+	if(!std::isnan(bval[0])) throw std::runtime_error("Duplicate BField grid point in " + asciifile);
+	for(size_t ib=0; ib<dims.size(); ib++) bval[ib] = point[dims.size()+ib];
+      }
+      if(npoints*dims.size() != data.size()) throw std::runtime_error("Incomplete BField grid in " + asciifile);
+      std::ofstream binary(binaryfile, std::ios::binary);
+      binary.write(reinterpret_cast<char const*>(&header),sizeof(header));
+      binary.write(reinterpret_cast<char const*>(data.data()),data.size()*sizeof(float));
+      if(!binary) throw std::runtime_error("Can't write BField grid file " + binaryfile);
+      return npoints;
+    }
+  }
+
+  GridBField::GridBField(std::string const& filename, Interp interp) : interp_(interp),
+  header_(mapGrid(filename,gridmagic,3,map_,mapsize_)),
+  data_(reinterpret_cast<float const*>(static_cast<char const*>(map_) + sizeof(Header))) {
+    if(header_->npts_[0] < 2 || header_->npts_[1] < 2 || header_->npts_[2] < 2){
+      munmap(map_,mapsize_);
+      throw std::runtime_error("Invalid BField grid in " + filename);
+    }
+  }
+
+  GridBField::~GridBField() { munmap(map_,mapsize_); }
+
+  Vec3 GridBField::field(size_t ix, size_t iy, size_t iz) const {
+    float const* bval = data_ + 3*((ix*header_->npts_[1] + iy)*header_->npts_[2] + iz);
+    return Vec3(bval[0],bval[1],bval[2]);
+  }
+
+  Vec3 GridBField::fieldVect(Vec3 const& position) const {
+    Vec3 fvec;
+    interpolate(position,fvec,0);
+    return fvec;
+  }
+
+  BField::Grad GridBField::fieldGrad(Vec3 const& position) const {
+    Vec3 fvec;
+    Grad fgrad;
+    interpolate(position,fvec,&fgrad);
+    return fgrad;
+  }
+
+  Vec3 GridBField::fieldDeriv(Vec3 const& position, Vec3 const& velocity) const {
+    // dB/dt = dB/dx * dx/dt
+    auto fgrad = fieldGrad(position);
+    ROOT::Math::SVector<double,3> vel(velocity.X(),velocity.Y(),velocity.Z());
+    auto dBdt = fgrad*vel;
+    return Vec3(dBdt[0],dBdt[1],dBdt[2]);
+  }
+
+  void GridBField::interpolate(Vec3 const& position, Vec3& fvec, Grad* fgrad) const {
+    // find the interpolation points and weights along each axis, and the derivatives of the weights
+    std::array<double,3> pos = {position.X(), position.Y(), position.Z()};
+    std::array<std::array<size_t,4>,3> index;
+    std::array<std::array<double,4>,3> wt, dwt;
+    std::array<bool,4> flip;
+    unsigned nw(0);
+    for(size_t idim=0; idim < 3; idim++)
+      nw = axisWeights(pos[idim],header_->npts_[idim],header_->origin_[idim],header_->spacing_[idim],interp_ == tricubic,false,
+	  index[idim],wt[idim],dwt[idim],flip);
+    // sum over the grid points
+    double bsum[3] = {0.0,0.0,0.0};
+    double gsum[3][3] = {{0.0,0.0,0.0},{0.0,0.0,0.0},{0.0,0.0,0.0}};
+    size_t ystride = header_->npts_[2], xstride = header_->npts_[1]*ystride;
+    for(unsigned ix=0;ix<nw;ix++){
+      for(unsigned iy=0;iy<nw;iy++){
+	double wxy = wt[0][ix]*wt[1][iy];
+	float const* bxy = data_ + 3*(index[0][ix]*xstride + index[1][iy]*ystride);
+	for(unsigned iz=0;iz<nw;iz++){
+	  float const* bval = bxy + 3*index[2][iz];
+	  double w = wxy*wt[2][iz];
+	  for(unsigned ib=0;ib<3;ib++) bsum[ib] += w*bval[ib];
+	  if(fgrad != 0){
+	    double dw[3] = {dwt[0][ix]*wt[1][iy]*wt[2][iz], wt[0][ix]*dwt[1][iy]*wt[2][iz], wxy*dwt[2][iz]};
+	    for(unsigned ib=0;ib<3;ib++)
+	      for(unsigned jdim=0;jdim<3;jdim++) gsum[ib][jdim] += dw[jdim]*bval[ib];
+	  }
+	}
+      }
+    }
+    fvec = Vec3(bsum[0],bsum[1],bsum[2]);
+    if(fgrad != 0){
+      for(unsigned ib=0;ib<3;ib++)
+	for(unsigned jdim=0;jdim<3;jdim++) (*fgrad)(ib,jdim) = gsum[ib][jdim];
+    }
+  }
+
+  size_t GridBField::convert(std::string const& asciifile, std::string const& binaryfile) {
+    return convertGrid(asciifile,binaryfile,gridmagic,{0,1,2});
+  }
+
+  RZGridBField::RZGridBField(std::string const& filename, Interp interp) : interp_(interp),
+  header_(mapGrid(filename,rzgridmagic,2,map_,mapsize_)),
+  data_(reinterpret_cast<float const*>(static_cast<char const*>(map_) + sizeof(Header))) {
+    if(header_->npts_[0] < 2 || header_->npts_[1] != 1 || header_->npts_[2] < 2 || header_->origin_[0] < 0.0){
+      munmap(map_,mapsize_);
+      throw std::runtime_error("Invalid BField grid in " + filename);
+    }
+  }
+
+  RZGridBField::~RZGridBField() { munmap(map_,mapsize_); }
+
+  Vec3 RZGridBField::field(size_t ir, size_t iz) const {
+    float const* bval = data_ + 2*(ir*header_->npts_[2] + iz);
+    return Vec3(bval[0],0.0,bval[1]);
+  }
+
+  Vec3 RZGridBField::fieldVect(Vec3 const& position) const {
+    double rad = position.Rho();
+    double br, bz;
+    interpolate(rad,position.Z(),br,bz,0,0);
+    if(rad > 0.0)
+      return Vec3(br*position.X()/rad,br*position.Y()/rad,bz);
+    else
+      return Vec3(0.0,0.0,bz);
+  }
+
+  BField::Grad RZGridBField::fieldGrad(Vec3 const& position) const {
+    double rad = position.Rho();
+    double br, bz, dbr[2], dbz[2];
+    interpolate(rad,position.Z(),br,bz,dbr,dbz);
+    // transform the (r,z) derivatives to cartesian.  Near the axis Br/r is replaced by its limit dBr/dr
+    double cphi(1.0), sphi(0.0), bovr(dbr[0]);
+    if(rad > 1.0e-6*header_->spacing_[0]){
+      cphi = position.X()/rad;
+      sphi = position.Y()/rad;
+      bovr = br/rad;
+    }
+    Grad fgrad;
+    fgrad(0,0) = dbr[0]*cphi*cphi + bovr*sphi*sphi;
+    fgrad(0,1) = fgrad(1,0) = (dbr[0] - bovr)*cphi*sphi;
+    fgrad(1,1) = dbr[0]*sphi*sphi + bovr*cphi*cphi;
+    fgrad(0,2) = dbr[1]*cphi;
+    fgrad(1,2) = dbr[1]*sphi;
+    fgrad(2,0) = dbz[0]*cphi;
+    fgrad(2,1) = dbz[0]*sphi;
+    fgrad(2,2) = dbz[1];
+    return fgrad;
+  }
+
+  Vec3 RZGridBField::fieldDeriv(Vec3 const& position, Vec3 const& velocity) const {
+    auto fgrad = fieldGrad(position);
+    ROOT::Math::SVector<double,3> vel(velocity.X(),velocity.Y(),velocity.Z());
+    auto dBdt = fgrad*vel;
+    return Vec3(dBdt[0],dBdt[1],dBdt[2]);
+  }
+
+  void RZGridBField::interpolate(double rad, double zpos, double& br, double& bz, double* dbr, double* dbz) const {
+    // when the grid starts on the axis, points at negative r are mirrored: Br is odd and Bz even in r
+    std::array<size_t,4> rindex, zindex;
+    std::array<double,4> rwt, drwt, zwt, dzwt;
+    std::array<bool,4> rflip, zflip;
+    bool cubic = interp_ == GridBField::tricubic;
+    unsigned nw = axisWeights(rad,header_->npts_[0],header_->origin_[0],header_->spacing_[0],cubic,header_->origin_[0] == 0.0,
+	rindex,rwt,drwt,rflip);
+    axisWeights(zpos,header_->npts_[2],header_->origin_[2],header_->spacing_[2],cubic,false,zindex,zwt,dzwt,zflip);
+    br = bz = 0.0;
+    double dbrsum[2] = {0.0,0.0}, dbzsum[2] = {0.0,0.0};
+    for(unsigned ir=0;ir<nw;ir++){
+      float const* brow = data_ + 2*rindex[ir]*header_->npts_[2];
+      double rsign = rflip[ir] ? -1.0 : 1.0;
+      for(unsigned iz=0;iz<nw;iz++){
+	float const* bval = brow + 2*zindex[iz];
+	double w = rwt[ir]*zwt[iz];
+	br += w*rsign*bval[0];
+	bz += w*bval[1];
+	if(dbr != 0){
+	  double dwr = drwt[ir]*zwt[iz], dwz = rwt[ir]*dzwt[iz];
+	  dbrsum[0] += dwr*rsign*bval[0];
+	  dbrsum[1] += dwz*rsign*bval[0];
+	  dbzsum[0] += dwr*bval[1];
+	  dbzsum[1] += dwz*bval[1];
+	}
+      }
+    }
+    if(dbr != 0){
+      dbr[0] = dbrsum[0]; dbr[1] = dbrsum[1];
+      dbz[0] = dbzsum[0]; dbz[1] = dbzsum[1];
+    }
+  }
+
+  size_t RZGridBField::convert(std::string const& asciifile, std::string const& binaryfile) {
+    return convertGrid(asciifile,binaryfile,rzgridmagic,{0,2});
+  }
+}
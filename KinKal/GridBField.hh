@@ -0,0 +1,87 @@
+#ifndef KinKal_GridBField_hh
+#define KinKal_GridBField_hh
+//
+//  BField interpolated on a regular 3D grid, such as a measured or computed solenoid map.  The grid is read from a
+//  compact binary file which is memory-mapped read-only, so loading is fast and the pages are shared by all the threads
+//  and processes using the same map.  The field is interpolated either trilinearly or tricubically (Catmull-Rom);
+//  the gradient is the derivative of the same interpolating function.  Positions outside the grid are clamped to
+//  the grid boundary.
+//  The binary file is created from an ASCII grid dump with 'convert'.
+//  RZGridBField is the equivalent for an axisymmetric field (ie a solenoid), interpolated on an (r,z) grid.  This
+//  is much smaller than a 3D grid of the same resolution, so it stays in cache.
+//
+#include "KinKal/BField.hh"
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+namespace KinKal {
+  class GridBField : public BField {
+    public:
+      enum Interp{trilinear=0, tricubic};
+      // binary file header; the field values follow as float triplets (Bx,By,Bz) in Tesla, with z varying fastest
+      struct Header {
+	char magic_[8]; // file type identifier
+	uint32_t version_; // format version, also checks byte order
+	uint32_t npts_[3]; // number of grid points in x, y, z
+	double origin_[3]; // position of the 1st grid point (mm)
+	double spacing_[3]; // distance between grid points (mm)
+      };
+      // map the given binary file
+      explicit GridBField(std::string const& filename, Interp interp=trilinear);
+      virtual ~GridBField();
+      // disallow copy and equivalence
+      GridBField(GridBField const& ) = delete;
+      GridBField& operator =(GridBField const& ) = delete;
+      virtual Vec3 fieldVect(Vec3 const& position) const override;
+      virtual Grad fieldGrad(Vec3 const& position) const override;
+      virtual Vec3 fieldDeriv(Vec3 const& position, Vec3 const& velocity) const override;
+      // accessors
+      Interp interpolation() const { return interp_; }
+      Header const& header() const { return *header_; }
+      size_t nPoints() const { return size_t(header_->npts_[0])*header_->npts_[1]*header_->npts_[2]; }
+      Vec3 field(size_t ix, size_t iy, size_t iz) const; // value at a grid point
+      // convert an ASCII grid dump to the binary format.  The ASCII file has 1 line per grid point, 'x y z Bx By Bz'
+      // (mm and Tesla), in any order.  Lines starting with '#' are ignored.  Returns the number of grid points.
+      static size_t convert(std::string const& asciifile, std::string const& binaryfile);
+    private:
+      // interpolate the field, and optionally the gradient, at a position
+      void interpolate(Vec3 const& position, Vec3& fvec, Grad* fgrad) const;
+      Interp interp_;
+      void* map_; // mapped file
+      size_t mapsize_;
+      Header const* header_;
+      float const* data_; // field values
+  };
+
+  class RZGridBField : public BField {
+    public:
+      typedef GridBField::Interp Interp;
+      typedef GridBField::Header Header;
+      // map the given binary file.  The file format is the same as GridBField, with the field values stored as
+      // (Br,Bz) pairs.  The 1st header dimension is r, the 3rd is z; the 2nd is unused
+      explicit RZGridBField(std::string const& filename, Interp interp=GridBField::trilinear);
+      virtual ~RZGridBField();
+      RZGridBField(RZGridBField const& ) = delete;
+      RZGridBField& operator =(RZGridBField const& ) = delete;
+      virtual Vec3 fieldVect(Vec3 const& position) const override;
+      virtual Grad fieldGrad(Vec3 const& position) const override;
+      virtual Vec3 fieldDeriv(Vec3 const& position, Vec3 const& velocity) const override;
+      // accessors
+      Interp interpolation() const { return interp_; }
+      Header const& header() const { return *header_; }
+      size_t nPoints() const { return size_t(header_->npts_[0])*header_->npts_[2]; }
+      Vec3 field(size_t ir, size_t iz) const; // value at a grid point, expressed at azimuth = 0 (ie in the x-z plane)
+      // convert an ASCII grid dump, 1 line per grid point 'r z Br Bz' (mm and Tesla), to the binary format
+      static size_t convert(std::string const& asciifile, std::string const& binaryfile);
+    private:
+      // interpolate Br and Bz, and optionally their derivatives WRT r and z
+      void interpolate(double rad, double zpos, double& br, double& bz, double* dbr, double* dbz) const;
+      Interp interp_;
+      void* map_;
+      size_t mapsize_;
+      Header const* header_;
+      float const* data_;
+  };
+}
+#endif
@@ -0,0 +1,48 @@
+#include "KinKal/KKArena.hh"
+#include <algorithm>
+#include <memory>
+namespace KinKal {
+  KKArena::KKArena(size_t blocksize, std::pmr::memory_resource* upstream) : blocksize_(blocksize), upstream_(upstream),
+  iblock_(0), offset_(0), used_(0) {}
+
+  KKArena::~KKArena() { release(); }
+
+  void KKArena::reset() {
+    iblock_ = 0;
+    offset_ = 0;
+    used_ = 0;
+  }
+
+  void KKArena::release() {
+    for(auto const& block : blocks_) upstream_->deallocate(block.mem_,block.size_,alignof(std::max_align_t));
+    blocks_.clear();
+    reset();
+  }
+
+  size_t KKArena::capacity() const {
+    size_t retval(0);
+    for(auto const& block : blocks_) retval += block.size_;
+    return retval;
+  }
+
+  void* KKArena::do_allocate(size_t bytes, size_t alignment) {
+    // look for space in the current or following blocks.  Blocks too small for this request are skipped
+    while(true){
+      if(iblock_ == blocks_.size()){
+	// no space: add a new block, large enough for this request
+	size_t size = std::max(blocksize_,bytes + alignment);
+	blocks_.push_back(Block{static_cast<std::byte*>(upstream_->allocate(size,alignof(std::max_align_t))),size});
+      }
+      auto const& block = blocks_[iblock_];
+      void* ptr = block.mem_ + offset_;
+      size_t space = block.size_ - offset_;
+      if(std::align(alignment,bytes,ptr,space)){
+	offset_ = block.size_ - space + bytes;
+	used_ += bytes;
+	return ptr;
+      }
+      iblock_++;
+      offset_ = 0;
+    }
+  }
+}
@@ -0,0 +1,46 @@
+#ifndef KinKal_KKArena_hh
+#define KinKal_KKArena_hh
+//
+//  Resettable arena memory resource for fit-scope allocations.  Memory is handed out sequentially from
+//  a list of blocks and individual deallocations are ignored.  reset() makes all the memory available again
+//  while keeping the blocks, so once the arena has grown to the size needed by an event, subsequent events
+//  are processed without any calls to the upstream allocator.
+//  All objects using the arena must be destroyed before it is reset.  The arena is not thread-safe: use 1 per thread.
+//
+#include <memory_resource>
+#include <vector>
+#include <cstddef>
+
+namespace KinKal {
+  class KKArena : public std::pmr::memory_resource {
+    public:
+      explicit KKArena(size_t blocksize=65536, std::pmr::memory_resource* upstream=std::pmr::new_delete_resource());
+      ~KKArena();
+      // disallow copy and equivalence
+      KKArena(KKArena const& ) = delete;
+      KKArena& operator =(KKArena const& ) = delete;
+      // release all the allocations, keeping the blocks for re-use
+      void reset();
+      // return the blocks to the upstream resource
+      void release();
+      // accessors
+      size_t nBlocks() const { return blocks_.size(); }
+      size_t capacity() const; // total memory held
+      size_t used() const { return used_; } // memory handed out since the last reset
+    private:
+      void* do_allocate(size_t bytes, size_t alignment) override;
+      void do_deallocate(void* , size_t , size_t ) override {} // memory is only recovered on reset
+      bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override { return this == &other; }
+      struct Block {
+	std::byte* mem_;
+	size_t size_;
+      };
+      size_t blocksize_; // default block size
+      std::pmr::memory_resource* upstream_; // source of the blocks
+      std::vector<Block> blocks_;
+      size_t iblock_; // current block
+      size_t offset_; // offset of the next free byte in the current block
+      size_t used_;
+  };
+}
+#endif
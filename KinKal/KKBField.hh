@@ -12,7 +12,7 @@
 #include <ostream>
 
 namespace KinKal {
-  template<class KTRAJ> class KKBField : public KKEff<KTRAJ> {
+  template<class KTRAJ> class KKBField final : public KKEff<KTRAJ> {
     public:
       typedef KKEff<KTRAJ> KKEFF;
       typedef PKTraj<KTRAJ> PKTRAJ;
@@ -24,19 +24,26 @@ namespace KinKal {
       virtual bool isActive() const override { return active_;}
       virtual void update(PKTRAJ const& ref) override;
       virtual void update(PKTRAJ const& ref, MConfig const& mconfig) override;
+      virtual void updateTemp(MConfig const& mconfig) override { KKEffBase::updateStatus(); } // no temperature dependence
+      virtual void approxUpdate(PKTRAJ const& ref, double tol) override;
       virtual void print(std::ostream& ost=std::cout,int detail=0) const override;
       virtual void process(KKDATA& kkdata,TDir tdir) override;
       virtual void append(PKTRAJ& fit) override;
       DVEC const& effect() const { return bfeff_; }
+      TRange const& range() const { return drange_; }
+      unsigned nFieldEvals() const { return nfeval_; } // number of field evaluations in the last integration
       virtual ~KKBField(){}
-      // create from the domain range, the effect, and the
-      KKBField(BField const& bfield, PKTRAJ const& pktraj,TRange const& drange) : 
-	bfield_(bfield), drange_(drange), active_(false) {} // not active until updated
+      // create from the domain range, the effect, and the tolerance on the integrated momentum change
+      KKBField(BField const& bfield, PKTRAJ const& pktraj,TRange const& drange, double btol=1.0e-4) : 
+	bfield_(&bfield), drange_(drange), btol_(btol), nfeval_(0), active_(false) {} // not active until updated
     private:
-      BField const& bfield_; // bfield
+      BField const* bfield_; // bfield
       TRange drange_; // extent of this domain
+      double btol_; // integration tolerance
+      unsigned nfeval_; // number of field evaluations
       Vec3 dpfrac_; // fractional change in momentum for BField diff from nominal over this range
       PDATA bfeff_; // effect of the difference beween the actual BField and bnom integrated over this range
+      PDATA ref_; // reference parameters used to compute the effect
       bool active_; // activity state
   };
 
@@ -56,7 +63,9 @@ namespace KinKal {
   }
 
   template<class KTRAJ> void KKBField<KTRAJ>::update(PKTRAJ const& ref) {
+    KKTRACE_SCOPE("KKBField::update");
     auto const& locref = ref.nearestPiece(drange_.mid()); 
+    ref_ = locref.params();
     double time = this->time();
     // translate the momentum change to the parameter change.
     // First get the derivatives and perp basis for the BField x-product at this point
@@ -71,12 +80,21 @@ namespace KinKal {
     KKEffBase::updateStatus();
   }
 
+  template<class KTRAJ> void KKBField<KTRAJ>::approxUpdate(PKTRAJ const& ref, double tol) {
+    // keep the correction computed for the previous reference, as the momentum derivatives barely change
+    if(KKEFF::unmoved(ref_,ref.nearestPiece(drange_.mid()).params(),tol))
+      KKEffBase::updateStatus();
+    else
+      update(ref);
+  }
+
   template<class KTRAJ> void KKBField<KTRAJ>::update(PKTRAJ const& ref, MConfig const& mconfig) {
+    KKTRACE_SCOPE("KKBField::update");
     if(mconfig.updatebfcorr_){
       active_ = true;
     // integrate the fractional momentum change
       Vec3 dp;
-      bfield_.integrate(ref,drange_,dp);
+      nfeval_ = bfield_->integrate(ref,drange_,dp,btol_);
       dpfrac_ = dp/ref.momentumMag(drange_.mid());
 //      std::cout << "Updating iteration " << mconfig.miter_ << " dP " << dp << std::endl;
     }
@@ -100,7 +118,7 @@ namespace KinKal {
 
   template<class KTRAJ> void KKBField<KTRAJ>::print(std::ostream& ost,int detail) const {
     ost << "KKBField " << static_cast<KKEff<KTRAJ>const&>(*this);
-    ost << " dP fraction " << dpfrac_ << " effect " << bfeff_.parameters() << " domain range " << drange_ << std::endl;
+    ost << " dP fraction " << dpfrac_ << " effect " << bfeff_.parameters() << " domain range " << drange_ << " field evaluations " << nfeval_ << std::endl;
   }
 
   template <class KTRAJ> std::ostream& operator <<(std::ostream& ost, KKBField<KTRAJ> const& kkmat) {
@@ -19,6 +19,16 @@ namespace KinKal {
   std::ostream& operator <<(std::ostream& ost, KKConfig kkconfig ) {
     ost << "KKConfig maxniter " << kkconfig.maxniter_ << " dweight " << kkconfig.dwt_
       << " min NDOF " << kkconfig.minndof_ 
+      << " BField tolerance " << kkconfig.tol_ << " mm, " << kkconfig.btol_ << " MeV/c, sample reuse " << kkconfig.bcachetol_ << " mm"
+      << " TPOCA precision " << kkconfig.tplimits_.precision_ << " max iterations " << kkconfig.tplimits_.maxiter_ << " max pieces " << kkconfig.tplimits_.maxpiece_;
+    if(kkconfig.pool_)
+      ost << " parallel update on " << kkconfig.pool_->nThreads() << " threads for " << kkconfig.minpareff_ << " or more effects"
+	<< (kkconfig.parsweep_ ? " with concurrent sweeps" : "");
+    if(kkconfig.rescaletemp_)
+      ost << " rescaling for temperature-only meta-iterations";
+    if(kkconfig.reftol_ > 0.0)
+      ost << " approximate update below " << kkconfig.reftol_ << " sigma reference change";
+    ost
       << " with " << kkconfig.schedule().size() << " Meta-iterations:" << std::endl;
     for(auto const& mconfig : kkconfig.schedule() ) {
       ost << mconfig << std::endl;
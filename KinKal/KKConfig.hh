@@ -9,10 +9,13 @@
 // constant until the algebraic iteration implicit in the extended Kalman fit methodology converges.
 //
 #include "KinKal/BField.hh"
+#include "KinKal/TPocaBase.hh"
+#include "KinKal/WorkStealingPool.hh"
 
 #include <vector>
 #include <memory>
 #include <algorithm>
+#include <limits>
 #include <any>
 #include <ostream>
 #include <istream>
@@ -34,13 +37,24 @@ namespace KinKal {
       is >> updatemat_ >> updatebfcorr_ >> updatehits_ >> temp_ >> convdchisq_ >> divdchisq_ >> oscdchisq_;
     }
     double varianceScale() const { return (1.0+temp_)*(1.0+temp_); } // variance scale so that temp=0 means no additional variance
+    // whether the effects need no update following the given meta-iteration other than for the temperature
+    bool tempOnly(MConfig const& prev) const { return !updatehits_ && updatemat_ == prev.updatemat_ && updatebfcorr_ == prev.updatebfcorr_; }
+  };
+
+  // parameters of the post-fit hit resolution pass (KKTrk::resolveHits)
+  struct HitResolution {
+    double maxchi_; // hits whose unbiased chi exceeds this (in any state) are deactivated
+    double minflip_; // minimum chisquared reduction to switch a hit to its alternative state (ie flip its LR ambiguity)
+    unsigned maxchange_; // maximum number of hits changed in one pass; the largest chisquared reductions are applied first
+    HitResolution(double maxchi=5.0, double minflip=1.0, unsigned maxchange=std::numeric_limits<unsigned>::max()) :
+      maxchi_(maxchi), minflip_(minflip), maxchange_(maxchange) {}
   };
 
   struct KKConfig {
     enum printLevel{none=-1, minimal, basic, complete, detailed, extreme};
     typedef std::vector<MConfig> MConfigCol;
     KKConfig(BField const& bfield,std::vector<MConfig>const& schedule) : KKConfig(bfield) { schedule_ = schedule; }
-    KKConfig(BField const& bfield) : bfield_(bfield),  maxniter_(10), dwt_(1.0e6),  tbuff_(0.5), tol_(0.1), minndof_(5), addmat_(true), addbf_(true), plevel_(none) {} 
+    KKConfig(BField const& bfield) : bfield_(bfield),  maxniter_(10), dwt_(1.0e6),  tbuff_(0.5), tol_(0.1), btol_(1.0e-4), bcachetol_(0.1), minndof_(5), addmat_(true), addbf_(true), minpareff_(64), parsweep_(true), rescaletemp_(false), reftol_(0.0), plevel_(none) {} 
     BField const& bfield() const { return bfield_; }
     MConfigCol const& schedule() const { return schedule_; }
     BField const& bfield_;
@@ -49,10 +63,24 @@ namespace KinKal {
     double dwt_; // dweighting of initial seed covariance
     double tbuff_; // time buffer for final fit (ns)
     double tol_; // tolerance on position change in BField integration (mm)
+    double btol_; // tolerance on the momentum change integrated over a BField domain (MeV/c)
+    double bcachetol_; // maximum reference trajectory movement for reusing a cached BField sample (mm)
     unsigned minndof_; // minimum number of DOFs to continue fit
     bool addmat_; // add material effects in the fit
     bool addbf_; // add BField effects in the fit
     Vec3 origin_; // nominal origin for defining BNom
+    TPocaLimits tplimits_; // convergence criteria for the hit TPOCA calculations
+    // if set, the effects of tracks with at least minpareff_ effects are updated concurrently on this pool, and if parsweep_
+    // is set the forward and backward sweeps of those tracks are run concurrently
+    std::shared_ptr<WorkStealingPool> pool_;
+    unsigned minpareff_;
+    bool parsweep_;
+    // if set, a meta-iteration which only changes the temperature (see MConfig::tempOnly) following a converged one
+    // starts by rescaling the effects, instead of updating them to the new fit
+    bool rescaletemp_;
+    // if positive, algebraic iterations only approximately update the effects whose local reference parameters moved by
+    // less than this many standard deviations (see KKEff::approxUpdate)
+    double reftol_;
     printLevel plevel_; // print level
     // schedule of meta-iterations.  These will be executed sequentially until completion or failure
     MConfigCol schedule_; 
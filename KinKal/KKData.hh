@@ -3,16 +3,20 @@
 //
 //  Data payload for processing the fit.  This object exists in both
 // parameter and weight space, with lazy evaluation to go between the
-// two with the minimum of matrix inversions
+// two with the minimum of matrix inversions.  Rank-1 (single measurement)
+// information is added to both representations directly, so that a sequence of
+// measurements can be processed without any inversions
 //
 #include "KinKal/WData.hh"
 #include "KinKal/PData.hh"
+#include "KinKal/FitStats.hh"
 #include <array>
 namespace KinKal {
   template <size_t DDIM> class KKData {
     public:
       typedef PData<DDIM> PDATA; // forward the type declarations
       typedef WData<DDIM> WDATA; 
+      typedef typename PDATA::DVEC DVEC;
       KKData() : hasPData_(false), hasWData_(false) {}
       KKData(PDATA const& pdata) : pdata_(pdata), hasPData_(true), hasWData_(false) {}
       KKData(WDATA const& wdata) : wdata_(wdata), hasPData_(false), hasWData_(true) {}
@@ -32,9 +36,29 @@ namespace KinKal {
 	hasWData_ = true;
 	hasPData_ = false;
       }
+      // add the information from a scalar measurement, described by its derivatives WRT the parameters (hvec),
+      // its value expressed as the projection of the parameters (hval), and its variance (hvar).  wdata must be the
+      // weight space representation of the same information.  Valid parameter space data are updated with
+      // the Sherman-Morrison formula, which doesn't require inverting the weight
+      void append(WDATA const& wdata, DVEC const& hvec, double hval, double hvar) {
+	if(hasPData_){
+	  DVEC chvec = pdata_.covariance()*hvec;
+	  double sinv = 1.0/(hvar + ROOT::Math::Dot(hvec,chvec));
+	  pdata_.parameters() += chvec*((hval - ROOT::Math::Dot(hvec,pdata_.parameters()))*sinv);
+	  // convert to matrices (for root) to get a symmetric update of the covariance
+	  ROOT::Math::SMatrix<double,DDIM,1> chvecM;
+	  chvecM.Place_in_col(chvec,0,0);
+	  ROOT::Math::SMatrix<double,1,1,ROOT::Math::MatRepSym<double,1> > sinvM;
+	  sinvM(0,0) = sinv;
+	  pdata_.covariance() -= ROOT::Math::Similarity(chvecM,sinvM);
+	  if(hasWData_) wdata_ += wdata;
+	} else
+	  append(wdata);
+      }
       PDATA& pData() { 
 	if(!hasPData_ && hasWData_ ){
 	  // invert the weight
+	  KKSTAT_COUNT(ninvert_,1);
 	  pdata_ = PDATA(wdata_);
 	  hasPData_ = true;
 	}
@@ -43,6 +67,7 @@ namespace KinKal {
       WDATA& wData() { 
 	if(!hasWData_ && hasPData_ ){
 	  // invert the parameters
+	  KKSTAT_COUNT(ninvert_,1);
 	  wdata_ = WDATA(pdata_);
 	  hasWData_ = true;
 	}
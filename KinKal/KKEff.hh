@@ -9,6 +9,7 @@
 #include "KinKal/KKData.hh"
 #include "KinKal/KKEffBase.hh"
 #include "KinKal/KKConfig.hh"
+#include "KinKal/KKTrace.hh"
 #include <array>
 #include <memory>
 #include <ostream>
@@ -33,6 +34,13 @@ namespace KinKal {
       virtual void update(PKTRAJ const& ref) = 0;
       // update this effect for a new configuration and reference trajectory
       virtual void update(PKTRAJ const& ref, MConfig const& mconfig) = 0;
+      // update this effect for a configuration differing only in annealing temperature, keeping the current reference
+      virtual void updateTemp(MConfig const& mconfig) = 0;
+      // update this effect for a new reference trajectory, allowing a cheaper approximate update if the local reference
+      // parameters moved by less than tol standard deviations.  By default this is the full update
+      virtual void approxUpdate(PKTRAJ const& ref, double tol) { update(ref); }
+      // whether every parameter changed by less than tol times its (new) uncertainty
+      static bool unmoved(PDATA const& oldpars, PDATA const& newpars, double tol);
       // append this effects trajectory change (if appropriate)
       virtual void append(PKTRAJ& fit) {};
       virtual void print(std::ostream& ost=std::cout,int detail=0) const =0;
@@ -41,6 +49,14 @@ namespace KinKal {
       KKEff() {}
   };
   
+  template<class KTRAJ> bool KKEff<KTRAJ>::unmoved(PDATA const& oldpars, PDATA const& newpars, double tol) {
+    for(size_t ipar=0;ipar < PDATA::PDim(); ipar++){
+      double dpar = newpars.parameters()[ipar] - oldpars.parameters()[ipar];
+      if(dpar*dpar > tol*tol*newpars.covariance()(ipar,ipar)) return false;
+    }
+    return true;
+  }
+
   template <class KTRAJ> std::ostream& operator <<(std::ostream& ost, KKEff<KTRAJ> const& eff) {
     ost << (eff.isActive() ? "Active " : "Inactive ") << "time " << eff.time() << " status " <<
     TDir::forwards << " " << KKEffBase::statusName(eff.status(TDir::forwards))  << " : " <<
@@ -9,7 +9,7 @@
 #include <ostream>
 
 namespace KinKal {
-  template<class KTRAJ> class KKEnd : public KKEff<KTRAJ> {
+  template<class KTRAJ> class KKEnd final : public KKEff<KTRAJ> {
     public:
       typedef KKEff<KTRAJ> KKEFF;
       typedef PKTraj<KTRAJ> PKTRAJ;
@@ -21,6 +21,7 @@ namespace KinKal {
       virtual void update(PKTRAJ const& ref, MConfig const& mconfig) override { 
 	vscale_ = mconfig.varianceScale(); // annealing scale for covariance deweighting, to avoid numerical effects
 	return update(ref); }
+      virtual void updateTemp(MConfig const& mconfig) override;
       virtual double time() const override { return (tdir_ == TDir::forwards) ? -std::numeric_limits<double>::max() : std::numeric_limits<double>::max(); } // make sure this is always at the end
       virtual bool isActive() const override { return true; }
       virtual void process(KKDATA& kkdata,TDir tdir) override;
@@ -60,6 +61,7 @@ namespace KinKal {
   }
 
   template<class KTRAJ> void KKEnd<KTRAJ>::update(PKTRAJ const& ref) {
+    KKTRACE_SCOPE("KKEnd::update");
     auto refend = ref.nearestPiece(time()).params();
     refend.covariance() *= (dwt_/vscale_);
     // convert this to a weight (inversion)
@@ -67,6 +69,15 @@ namespace KinKal {
     KKEffBase::updateStatus();
   }
 
+  template<class KTRAJ> void KKEnd<KTRAJ>::updateTemp(MConfig const& mconfig) {
+    // the deweighted end weight is proportional to the variance scale
+    double vscale = mconfig.varianceScale();
+    endeff_.weightMat() *= vscale/vscale_;
+    endeff_.weightVec() *= vscale/vscale_;
+    vscale_ = vscale;
+    KKEffBase::updateStatus();
+  }
+
   template<class KTRAJ> void KKEnd<KTRAJ>::append(PKTRAJ& fit) {
     // if the fit is empty and we're going in the right direction, take the end cache and
     // seed the fit with it
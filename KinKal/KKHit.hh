@@ -11,9 +11,10 @@
 #include "KinKal/Residual.hh"
 #include <ostream>
 #include <memory>
+#include <array>
 
 namespace KinKal {
-  template <class KTRAJ> class KKHit : public KKEff<KTRAJ> {
+  template <class KTRAJ> class KKHit final : public KKEff<KTRAJ> {
     public:
       typedef KKEff<KTRAJ> KKEFF;
       typedef PKTraj<KTRAJ> PKTRAJ;
@@ -30,6 +31,8 @@ namespace KinKal {
       virtual double chisq(PDATA const& pdata) const override{ double chival = chi(pdata); return chival*chival; } 
       virtual void update(PKTRAJ const& pktraj)  override;
       virtual void update(PKTRAJ const& pktraj, MConfig const& mconfig) override;
+      virtual void updateTemp(MConfig const& mconfig) override;
+      virtual void approxUpdate(PKTRAJ const& pktraj, double tol) override;
       virtual void process(KKDATA& kkdata,TDir tdir) override;
       virtual bool isActive() const override { return thit_->isActive(); }
       virtual double time() const override { return rresid_.time(); } // time on the particle trajectory
@@ -40,20 +43,26 @@ namespace KinKal {
       // construct from a hit and reference trajectory
       KKHit(THITPTR const& thit, PKTRAJ const& reftraj);
       // interface for reduced residual
-      double chi(PDATA const& pdata) const;
+      double chi(PDATA const& pdata) const { return chi(pdata,rresid_); }
+      // reduced residual of the alternative state of the hit (see THit), WRT the given parameters.  Returns false if there is none
+      bool altChi(PDATA const& pdata, double& altchi) const;
+      // parameters at this hit excluding its own information, from the last processing in both directions.  This inverts
+      // the weight cache
+      bool unbiasedParams(PDATA& unbiased) const;
       // accessors
       THITPTR const& tHit() const { return thit_; }
       RESIDUAL const& refResid() const { return rresid_; }
       PDATA const& refParams() const { return ref_; }
-      WDATA const& weightCache() const { return wcache_; }
+      WDATA weightCache() const { WDATA retval(wcache_[0]); retval += wcache_[1]; return retval; }
       // compute the reduced residual
     private:
       THITPTR thit_ ; // hit used for this constraint
       PDATA ref_; // reference parameters
-      WDATA wcache_; // sum of processing weights in opposite directions, excluding this hit's information. used to compute chisquared and reduced residuals
+      std::array<WDATA,2> wcache_; // processing weights in each direction, excluding this hit's information.  Their sum is used to compute chisquared and reduced residuals
       WDATA hiteff_; // wdata representation of this effect's constraint/measurement
       RESIDUAL rresid_; // residuals for this reference and hit
       double vscale_; // variance factor due to annealing 'temperature'
+      double chi(PDATA const& pdata, RESIDUAL const& resid) const;
   };
 
   template<class KTRAJ> KKHit<KTRAJ>::KKHit(THITPTR const& thit, PKTRAJ const& reftraj) : thit_(thit), vscale_(1.0) {
@@ -63,21 +72,25 @@ namespace KinKal {
   template<class KTRAJ> void KKHit<KTRAJ>::process(KKDATA& kkdata,TDir tdir) {
     // direction is irrelevant for adding information
     if(this->isActive()){
-      // cache the processing weights, adding both processing directions
-      wcache_ += kkdata.wData();
-      // add this effect's information
-      kkdata.append(hiteff_);
+      // cache the processing weights.  These are kept separately for each direction, so the directions can be processed concurrently
+      wcache_[static_cast<std::underlying_type<TDir>::type>(tdir)] += kkdata.wData();
+      // add this effect's information.  This is a rank-1 constraint on the parameters, so pass the components
+      // directly to avoid inverting the weight
+      double hval = ROOT::Math::Dot(rresid_.dRdP(),ref_.parameters()) + rresid_.value();
+      kkdata.append(hiteff_,rresid_.dRdP(),hval,rresid_.variance()*vscale_);
     }
     KKEffBase::setStatus(tdir,KKEffBase::processed);
   }
 
   template<class KTRAJ> void KKHit<KTRAJ>::update(PKTRAJ const& pktraj) {
+    KKTRACE_SCOPE("KKHit::update");
     // compute residual and derivatives from hit using reference parameters
     thit_->resid(pktraj, rresid_);
     updateCache(pktraj);
   }
 
   template<class KTRAJ> void KKHit<KTRAJ>::update(PKTRAJ const& pktraj, MConfig const& mconfig) {
+    KKTRACE_SCOPE("KKHit::update");
     // reset the annealing temp
     vscale_ = mconfig.varianceScale();
     // update the hit internal state; this can depend on specific configuration parameters
@@ -89,9 +102,29 @@ namespace KinKal {
     updateCache(pktraj);
   }
 
+  template<class KTRAJ> void KKHit<KTRAJ>::approxUpdate(PKTRAJ const& pktraj, double tol) {
+    // the constraint is linear about ref_, so it stays valid while the reference is close to it.  Comparing against
+    // ref_ (not the previous reference) keeps small changes from accumulating
+    if(KKEFF::unmoved(ref_,pktraj.nearestPiece(rresid_.time()).params(),tol)){
+      wcache_ = {WDATA(),WDATA()};
+      KKEffBase::updateStatus();
+    } else
+      update(pktraj);
+  }
+
+  template<class KTRAJ> void KKHit<KTRAJ>::updateTemp(MConfig const& mconfig) {
+    // the constraint weight is inversely proportional to the variance scale
+    double vscale = mconfig.varianceScale();
+    hiteff_.weightMat() *= vscale_/vscale;
+    hiteff_.weightVec() *= vscale_/vscale;
+    vscale_ = vscale;
+    wcache_ = {WDATA(),WDATA()};
+    KKEffBase::updateStatus();
+  }
+
   template<class KTRAJ> void KKHit<KTRAJ>::updateCache(PKTRAJ const& pktraj) {
     // reset the processing cache
-    wcache_ = WDATA();
+    wcache_ = {WDATA(),WDATA()};
     // scale resid variance by temp normalization
     double tvar = rresid_.variance()*vscale_; 
     ref_ = pktraj.nearestPiece(rresid_.time()).params();
@@ -112,25 +145,38 @@ namespace KinKal {
 
   template<class KTRAJ> double KKHit<KTRAJ>::fitChi() const {
     double retval(0.0);
+    PDATA unbiased;
+    if(unbiasedParams(unbiased)) retval = chi(unbiased);
+    return retval;
+  }
+
+  template<class KTRAJ> bool KKHit<KTRAJ>::unbiasedParams(PDATA& unbiased) const {
     if(this->isActive() && KKEffBase::wasProcessed(TDir::forwards) && KKEffBase::wasProcessed(TDir::backwards)) {
     // Invert the cache to get unbiased parameters at this hit
-      PDATA unbiased(wcache_);
-      retval = chi(unbiased);
+      unbiased = PDATA(weightCache());
+      return true;
     }
-    return retval;
+    return false;
+  }
+
+  template<class KTRAJ> bool KKHit<KTRAJ>::altChi(PDATA const& pdata, double& altchi) const {
+    RESIDUAL altresid;
+    if(!this->isActive() || !thit_->altResid(rresid_,altresid)) return false;
+    altchi = chi(pdata,altresid);
+    return true;
   }
 
-  template<class KTRAJ> double KKHit<KTRAJ>::chi(PDATA const& pdata) const {
+  template<class KTRAJ> double KKHit<KTRAJ>::chi(PDATA const& pdata, RESIDUAL const& resid) const {
     double retval(0.0);
     if(this->isActive()) {
       // compute the difference between these parameters and the reference parameters
       DVEC dpvec = pdata.parameters() - ref_.parameters(); 
       // use the differnce to 'correct' the reference residual to be WRT these parameters
-      double uresid = rresid_.value() - ROOT::Math::Dot(dpvec,rresid_.dRdP());
+      double uresid = resid.value() - ROOT::Math::Dot(dpvec,resid.dRdP());
       // project the parameter covariance into a residual space variance
-      double rvar = ROOT::Math::Similarity(rresid_.dRdP(),pdata.covariance());
+      double rvar = ROOT::Math::Similarity(resid.dRdP(),pdata.covariance());
       // add the measurement variance, scaled by the current temperature normalization
-      rvar +=  rresid_.variance()*vscale_;
+      rvar +=  resid.variance()*vscale_;
       // chi is the ratio of these
       retval = uresid/sqrt(rvar);
     }
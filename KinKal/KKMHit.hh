@@ -11,7 +11,7 @@
 #include <memory>
 
 namespace KinKal {
-  template <class KTRAJ> class KKMHit : public KKEff<KTRAJ> {
+  template <class KTRAJ> class KKMHit final : public KKEff<KTRAJ> {
     public:
       typedef KKEff<KTRAJ> KKEFF;
       typedef KKHit<KTRAJ> KKHIT;
@@ -32,6 +32,8 @@ namespace KinKal {
       virtual double chisq(PDATA const& pdata) const override { return kkhit_.chisq(pdata); }
       virtual void update(PKTRAJ const& ref) override;
       virtual void update(PKTRAJ const& ref, MConfig const& mconfig) override;
+      virtual void updateTemp(MConfig const& mconfig) override { KKEffBase::updateStatus(); kkhit_.updateTemp(mconfig); kkmat_.updateTemp(mconfig); }
+      virtual void approxUpdate(PKTRAJ const& ref, double tol) override;
       virtual void append(PKTRAJ& fit) override { return kkmat_.append(fit); }
       virtual void print(std::ostream& ost=std::cout,int detail=0) const override;
       // accessors
@@ -60,6 +62,7 @@ namespace KinKal {
   }
 
   template <class KTRAJ> void KKMHit<KTRAJ>::update(PKTRAJ const& pktraj) {
+    KKTRACE_SCOPE("KKMHit::update");
     if(pktraj.range().infinite())throw std::invalid_argument("Invalid range");
     // update the hit first, then use that to update the material 
     KKEffBase::updateStatus();
@@ -68,11 +71,20 @@ namespace KinKal {
     kkmat_.update(pktraj);
   }
   
+  template <class KTRAJ> void KKMHit<KTRAJ>::approxUpdate(PKTRAJ const& pktraj, double tol) {
+    KKEffBase::updateStatus();
+    kkhit_.approxUpdate(pktraj,tol);
+    kkmat_.setTime(kkhit_.time());
+    kkmat_.approxUpdate(pktraj,tol);
+  }
+
   template <class KTRAJ> void KKMHit<KTRAJ>::update(PKTRAJ const& pktraj, MConfig const& mconfig) {
+    KKTRACE_SCOPE("KKMHit::update");
     KKEffBase::updateStatus();
     kkhit_.update(pktraj,mconfig);
     kkmat_.setTime(kkhit_.time());
-    kkmat_.update(pktraj,mconfig);
+    // the hit and material share the same sensor, so the material can re-use the hit TPOCA
+    kkmat_.update(pktraj,mconfig,kkhit_.refResid().tPoca());
   }
 
   template <class KTRAJ> void KKMHit<KTRAJ>::print(std::ostream& ost, int detail) const {
@@ -14,7 +14,7 @@
 #include <ostream>
 
 namespace KinKal {
-  template<class KTRAJ> class KKMat : public KKEff<KTRAJ> {
+  template<class KTRAJ> class KKMat final : public KKEff<KTRAJ> {
     public:
       typedef KKEff<KTRAJ> KKEFF;
       typedef PKTraj<KTRAJ> PKTRAJ;
@@ -28,11 +28,15 @@ namespace KinKal {
       virtual bool isActive() const override { return active_ && dxing_->matXings().size() > 0; }
       virtual void update(PKTRAJ const& ref) override;
       virtual void update(PKTRAJ const& ref, MConfig const& mconfig) override;
+      // update using a TPOCA already computed for the sensor of this material (ie by an associated hit)
+      void update(PKTRAJ const& ref, MConfig const& mconfig, TPocaBase const& tpoca);
+      virtual void updateTemp(MConfig const& mconfig) override;
+      virtual void approxUpdate(PKTRAJ const& ref, double tol) override;
       virtual void print(std::ostream& ost=std::cout,int detail=0) const override;
       virtual void process(KKDATA& kkdata,TDir tdir) override;
       virtual void append(PKTRAJ& fit) override;
       PDATA const& effect() const { return mateff_; }
-      WDATA const& cache() const { return cache_; }
+      WDATA cache() const { WDATA retval(cache_[0]); retval += cache_[1]; return retval; }
       void setTime(double time) { dxing_->crossingTime() = time; }
       virtual ~KKMat(){}
       // create from the material and a trajectory 
@@ -41,28 +45,35 @@ namespace KinKal {
     private:
       // update the local cache
       void updateCache();
+      // without an update, the cache keeps accumulating.  Fold it into the forwards entry so the sum is independent of the sweep order
+      void foldCache() { cache_[0] += cache_[1]; cache_[1] = WDATA(); }
+      // rescale the effect variance to the current temperature without rebuilding it
+      void rescaleEffect() { mateff_.covariance() *= vscale_/matvscale_; matvscale_ = vscale_; }
       DXINGPTR dxing_; // detector piece crossing for this effect
       KTRAJ ref_; // reference to local trajectory
       PDATA mateff_; // parameter space description of this effect
-      WDATA cache_; // cache of weight processing in opposite directions, used to build the fit trajectory
+      std::array<WDATA,2> cache_; // cache of weight processing in each direction, whose sum is used to build the fit trajectory
       double vscale_; // variance factor due to annealing 'temperature'
+      double matvscale_; // variance factor mateff_ was built with
       bool active_;
   };
 
    template<class KTRAJ> KKMat<KTRAJ>::KKMat(DXINGPTR const& dxing, PKTRAJ const& pktraj, bool active) : dxing_(dxing), 
-   ref_(pktraj.nearestPiece(dxing->crossingTime())), vscale_(1.0), active_(active) {
+   ref_(pktraj.nearestPiece(dxing->crossingTime())), vscale_(1.0), matvscale_(1.0), active_(active) {
      update(pktraj);
    }
 
   template<class KTRAJ> void KKMat<KTRAJ>::process(KKDATA& kkdata,TDir tdir) {
     if(active_){
+      // the directions are cached separately, so they can be processed concurrently
+      auto idir = static_cast<std::underlying_type<TDir>::type>(tdir);
       // forwards, set the cache AFTER processing this effect
       if(tdir == TDir::forwards) {
 	kkdata.append(mateff_);
-	cache_ += kkdata.wData();
+	cache_[idir] += kkdata.wData();
       } else {
       // backwards, set the cache BEFORE processing this effect, to avoid double-counting it
-	cache_ += kkdata.wData();
+	cache_[idir] += kkdata.wData();
 	// SUBTRACT the effect going backwards: covariance change is sign-independent
 	PDATA reverse(mateff_);
 	reverse.parameters() *= -1.0;
@@ -73,24 +84,58 @@ namespace KinKal {
   }
 
   template<class KTRAJ> void KKMat<KTRAJ>::update(PKTRAJ const& ref) {
-    cache_ = WDATA();
+    KKTRACE_SCOPE("KKMat::update");
+    cache_ = {WDATA(),WDATA()};
     ref_ = ref.nearestPiece(dxing_->crossingTime()); 
     updateCache();
     KKEffBase::updateStatus();
   }
 
   template<class KTRAJ> void KKMat<KTRAJ>::update(PKTRAJ const& ref, MConfig const& mconfig) {
+    KKTRACE_SCOPE("KKMat::update");
     vscale_ = mconfig.varianceScale();
     if(mconfig.updatemat_){
       // update the detector Xings for this effect
       dxing_->update(ref);
       // should check to see if this material is still active FIXME!
       update(ref);
-    }
+    } else
+      foldCache();
+  }
+
+  template<class KTRAJ> void KKMat<KTRAJ>::update(PKTRAJ const& ref, MConfig const& mconfig, TPocaBase const& tpoca) {
+    KKTRACE_SCOPE("KKMat::update");
+    vscale_ = mconfig.varianceScale();
+    if(mconfig.updatemat_){
+      dxing_->update(tpoca);
+      update(ref);
+    } else
+      foldCache();
+  }
+
+  template<class KTRAJ> void KKMat<KTRAJ>::approxUpdate(PKTRAJ const& ref, double tol) {
+    // the material effect is insensitive to small changes of the reference, so keep it
+    if(KKEFF::unmoved(ref_.params(),ref.nearestPiece(dxing_->crossingTime()).params(),tol)){
+      // the temperature may have changed since the effect was built
+      if(matvscale_ != vscale_)rescaleEffect();
+      cache_ = {WDATA(),WDATA()};
+      KKEffBase::updateStatus();
+    } else
+      update(ref);
+  }
+
+  template<class KTRAJ> void KKMat<KTRAJ>::updateTemp(MConfig const& mconfig) {
+    // only the scattering and straggling variance depends on the temperature
+    // rescale from the variance the effect was built with, as vscale_ can change without rebuilding it
+    vscale_ = mconfig.varianceScale();
+    rescaleEffect();
+    cache_ = {WDATA(),WDATA()};
+    KKEffBase::updateStatus();
   }
 
   template<class KTRAJ> void KKMat<KTRAJ>::updateCache() {
     mateff_ = PDATA();
+    matvscale_ = vscale_;
     if(dxing_->matXings().size() > 0){
       // loop over the momentum change basis directions, adding up the effects on parameters from each
       std::array<double,3> dmom = {0.0,0.0,0.0}, momvar = {0.0,0.0,0.0};
@@ -117,7 +162,7 @@ namespace KinKal {
       // create a trajectory piece from the cached weight
       double time = this->time();
       KTRAJ newpiece(ref_);
-      newpiece.params() = PDATA(cache_);
+      newpiece.params() = PDATA(cache());
       newpiece.range() = TRange(time,fit.range().high());
       // make sure the piece is appendable
       if(time > fit.back().range().low()){
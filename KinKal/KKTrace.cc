@@ -0,0 +1,82 @@
+#include "KinKal/KKTrace.hh"
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+namespace KinKal {
+  namespace {
+    struct ThreadBuffer {
+      unsigned tid_; // sequential thread number, in order of first use
+      std::vector<KKTrace::Span> spans_;
+    };
+    // buffers of all the threads which have recorded spans.  The mutex guards the buffer list, not the buffer contents
+    struct Registry {
+      std::mutex mutex_;
+      std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+      KKTrace::Clock::time_point epoch_ = KKTrace::Clock::now(); // origin of the trace timestamps
+    };
+    Registry& registry() {
+      static Registry reg;
+      return reg;
+    }
+    ThreadBuffer* registerThread() {
+      auto& reg = registry();
+      std::lock_guard<std::mutex> lock(reg.mutex_);
+      reg.buffers_.emplace_back(std::make_unique<ThreadBuffer>());
+      reg.buffers_.back()->tid_ = reg.buffers_.size();
+      reg.buffers_.back()->spans_.reserve(4096);
+      return reg.buffers_.back().get();
+    }
+  }
+
+  void KKTrace::record(Span const& span) {
+    static thread_local ThreadBuffer* buffer = registerThread();
+    buffer->spans_.push_back(span);
+  }
+
+  size_t KKTrace::write(std::ostream& os) {
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex_);
+    auto usec = [&reg](Clock::time_point time) { return std::chrono::duration<double,std::micro>(time-reg.epoch_).count(); };
+    size_t nspans(0);
+    os << "{\"traceEvents\":[";
+    const char* sep = "\n";
+    for(auto const& buffer : reg.buffers_){
+      os << sep << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->tid_
+	<< ",\"args\":{\"name\":\"KinKal thread " << buffer->tid_ << "\"}}";
+      sep = ",\n";
+      for(auto const& span : buffer->spans_){
+	// names are literals from the instrumented code, so need no escaping
+	os << sep << "{\"name\":\"" << span.name_ << "\",\"cat\":\"KinKal\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->tid_
+	  << ",\"ts\":" << usec(span.start_) << ",\"dur\":" << usec(span.stop_) - usec(span.start_);
+	if(span.arg_ >= 0) os << ",\"args\":{\"n\":" << span.arg_ << "}";
+	os << "}";
+	nspans++;
+      }
+    }
+    os << "\n],\"displayTimeUnit\":\"ms\"}" << std::endl;
+    return nspans;
+  }
+
+  size_t KKTrace::write(std::string const& filename) {
+    std::ofstream ofs(filename);
+    if(!ofs)throw std::runtime_error("Can't open trace file " + filename);
+    size_t nspans = write(ofs);
+    if(!ofs)throw std::runtime_error("Error writing trace file " + filename);
+    return nspans;
+  }
+
+  size_t KKTrace::nSpans() {
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex_);
+    size_t nspans(0);
+    for(auto const& buffer : reg.buffers_) nspans += buffer->spans_.size();
+    return nspans;
+  }
+
+  void KKTrace::clear() {
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex_);
+    for(auto& buffer : reg.buffers_) buffer->spans_.clear();
+  }
+}
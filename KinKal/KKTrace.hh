@@ -0,0 +1,56 @@
+#ifndef KinKal_KKTrace_hh
+#define KinKal_KKTrace_hh
+//
+//  Timeline tracing of the fit execution.  Scoped spans (name, start, duration, thread) are recorded and written as a
+//  Chrome trace JSON file, which can be viewed with chrome://tracing or https://ui.perfetto.dev.
+//  Each thread records into its own buffer, so recording takes no locks; a thread's buffer is registered (under a mutex)
+//  the first time it records a span, and is kept after the thread exits.  Only the pointer to the span name is stored,
+//  so names must be string literals.  write and clear must not be called while spans are being recorded.
+//  The spans are only compiled in when KINKAL_TRACE is defined; otherwise KKTRACE_SCOPE expands to nothing.
+//
+#include <chrono>
+#include <vector>
+#include <string>
+#include <ostream>
+
+namespace KinKal {
+  class KKTrace {
+    public:
+      typedef std::chrono::steady_clock Clock;
+      struct Span {
+	const char* name_; // span name
+	int arg_; // optional argument (ie iteration number), <0 if none
+	Clock::time_point start_, stop_; // span interval
+      };
+      // record the time between construction and destruction as a span on the calling thread
+      class Scope {
+	public:
+	  explicit Scope(const char* name, int arg=-1) : name_(name), arg_(arg), start_(Clock::now()) {}
+	  ~Scope() { record(Span{name_,arg_,start_,Clock::now()}); }
+	  Scope(Scope const&) = delete;
+	  Scope& operator =(Scope const&) = delete;
+	private:
+	  const char* name_;
+	  int arg_;
+	  Clock::time_point start_;
+      };
+      // record a completed span on the calling thread
+      static void record(Span const& span);
+      // write all the recorded spans in Chrome trace format, returning the number of spans written.  The file version
+      // throws if the file can't be written
+      static size_t write(std::ostream& os);
+      static size_t write(std::string const& filename);
+      // number of recorded spans, and removal of all of them
+      static size_t nSpans();
+      static void clear();
+  };
+}
+
+#ifdef KINKAL_TRACE
+#define KKTRACE_CAT2(a,b) a##b
+#define KKTRACE_CAT(a,b) KKTRACE_CAT2(a,b)
+#define KKTRACE_SCOPE(...) KinKal::KKTrace::Scope KKTRACE_CAT(kktrace_scope_,__LINE__)(__VA_ARGS__)
+#else
+#define KKTRACE_SCOPE(...) ((void)0)
+#endif
+#endif
@@ -28,10 +28,21 @@
 //  The underlying processing model is a progressive BLUE fit first used in the geometric track fit implementation used by the BaBar
 //  collaboration, described in "D.N. Brown, E.A. Charles, D.A. Roberts, The BABAR track fitting algorithm, Proceedings of CHEP 2000, Padova, Italy, 2000"
 //
+//  The effects are stored by value in a single time-ordered container of variants, so that the Kalman sweeps run over
+//  contiguous memory and dispatch to the concrete effect classes statically.
+//
+//  All the memory owned by KKTrk (effects, trajectories, history) is allocated from the memory resource given on construction.
+//  Using a KKArena that is reset between events avoids any heap allocation in steady-state processing; in that case
+//  the KKTrk objects must be destroyed before the arena is reset.
+//
+//  When built with KINKAL_FITSTATS, each history entry also records the operation counts and phase timing of its
+//  iteration, and the totals of its meta-iteration so far (see FitStats).
+//
 //  KKTrk is constructed from a configuration object which can be shared between many instances, and a unique set of hit and
 //  material interactions.  The configuration object controls the fit iteration convergence testing, including simulated
 //  annealing and interactions with the external environment such as the material model and the magnetic field map.
-//  The fit is performed on construction.
+//  The fit is performed on construction.  Hits can afterwards be added to or removed from the fit; the existing effects
+//  and the current fit (as reference) are kept, and only a short schedule of meta-iterations is run to refit.
 //
 //  The KinKal package is licensed under Adobe v2, and is hosted at https://github.com/KFTrack/KinKal.git
 //  David N. Brown, Lawrence Berkeley National Lab
@@ -48,10 +59,15 @@
 #include "KinKal/THit.hh"
 #include "KinKal/KKConfig.hh"
 #include "KinKal/FitStatus.hh"
+#include "KinKal/KKTrace.hh"
 #include "KinKal/BField.hh"
+#include "KinKal/BFieldCache.hh"
 #include "TMath.h"
 #include <set>
 #include <vector>
+#include <variant>
+#include <memory_resource>
+#include <algorithm>
 #include <iterator>
 #include <memory>
 #include <cmath>
@@ -76,110 +92,324 @@ namespace KinKal {
       typedef std::shared_ptr<DXING> DXINGPTR;
       typedef std::vector<THITPTR> THITCOL;
       typedef std::vector<DXINGPTR> DXINGCOL;
+      typedef KKConfig::MConfigCol MCONFIGCOL;
       typedef typename KTRAJ::PDATA PDATA;
       typedef typename PDATA::DVEC DVEC;
+      typedef std::variant<KKHIT,KKMHIT,KKMAT,KKBFIELD,KKEND> KKEFFV; // any concrete effect
+      typedef std::pmr::vector<KKEFFV> KKEFFCOL; // container type for effects
+      typedef std::pmr::vector<FitStatus> FSCOL;
+      typedef std::pmr::vector<THITPTR> THITREFS; // fit-owned references to the hits and crossings
+      typedef std::pmr::vector<DXINGPTR> DXINGREFS;
+      // generic (virtual) access to an effect, for use outside the fit processing
+      static KKEFF const& effect(KKEFFV const& effv) { return std::visit([](auto const& eff) -> KKEFF const& { return eff; }, effv); }
+      static double effTime(KKEFFV const& effv) { return std::visit([](auto const& eff) { return eff.time(); }, effv); }
       struct KKEFFComp { // comparator to sort effects by time
-	bool operator()(std::unique_ptr<KKEFF> const& a, std::unique_ptr<KKEFF> const&  b) const {
-	  if(a.get() != b.get())
-	    return a->time() < b->time();
-	  else
-	    return false;
-	}
+	bool operator()(KKEFFV const& a, KKEFFV const& b) const { return effTime(a) < effTime(b); }
       };
-      typedef std::vector<std::unique_ptr<KKEFF> > KKEFFCOL; // container type for effects
-      // construct from a set of hits and passive material crossings
-      KKTrk(KKCONFIGPTR const& kkconfig, PKTRAJ const& reftraj, THITCOL& thits, DXINGCOL& dxings ); 
+      // construct from a set of hits and passive material crossings, allocating memory from the given resource
+      KKTrk(KKCONFIGPTR const& kkconfig, PKTRAJ const& reftraj, THITCOL& thits, DXINGCOL& dxings,
+	  std::pmr::memory_resource* mres=std::pmr::get_default_resource()); 
       void fit(); // process the effects.  This creates the fit
+      // add hits (and their associated material) to the fit, or remove a hit from it, then refit with the given
+      // meta-iterations, by default the last meta-iteration of the configuration schedule.  A removed hit's material stays
+      // in the fit.  addHits ignores hits already in this fit and returns the number added; removeHit returns false if the
+      // hit isn't part of this fit.  Neither refits if nothing changed
+      unsigned addHits(THITCOL const& thits, MCONFIGCOL const& schedule=MCONFIGCOL());
+      bool removeHit(THITPTR const& thit, MCONFIGCOL const& schedule=MCONFIGCOL());
+      // post-fit outlier rejection and ambiguity resolution.  The unbiased parameters cached at each hit by the last
+      // iteration give the chisquared change from deactivating the hit or switching it to its alternative state (ie
+      // flipping its LR ambiguity), for all hits at once.  The best changes are applied and the fit is continued as for
+      // addHits, but without updating the hits.  Returns the number of hits changed
+      unsigned resolveHits(HitResolution const& hres=HitResolution(), MCONFIGCOL const& schedule=MCONFIGCOL());
       // accessors
-      std::vector<FitStatus> const& history() const { return history_; }
+      FSCOL const& history() const { return history_; }
       FitStatus const& fitStatus() const { return history_.back(); } // most recent status
       PKTRAJ const& refTraj() const { return reftraj_; }
-      PKTRAJ const& fitTraj() const { return fittraj_; }
+      PKTRAJ const& fitTraj() const { return newfit_ ? fittraj_ : reftraj_; } // most recent fit result
       KKEFFCOL const& effects() const { return effects_; }
       KKConfig const& config() const { return *kkconfig_; }
-      THITCOL const& timeHits() const { return thits_; } 
-      DXINGCOL const& detMatXings() const { return dxings_; }
+      THITREFS const& timeHits() const { return thits_; } 
+      DXINGREFS const& detMatXings() const { return dxings_; }
       void print(std::ostream& ost=std::cout,int detail=0) const;
     private:
       // helper functions
-      void update(FitStatus const& fstat, MConfig const& mconfig);
+      void fit(typename MCONFIGCOL::const_iterator first, typename MCONFIGCOL::const_iterator last, int miter0);
+      void refit(MCONFIGCOL const& schedule);
+      void createHitEffect(THITPTR const& thit);
+      void extendRange();
+      void update(FitStatus const& fstat, MConfig const& mconfig, bool rescale);
+      void updateEffects(MConfig const* mconfig);
+      void forwardSweep(FitStatus& status);
+      void backwardSweep();
+      bool parallel() const; // whether to use the configured thread pool
+      void runTasks(WorkStealingPool::TASKCOL& tasks) const; // run tasks on the configured thread pool
+      template <class F> void runBlocks(const char* name, size_t nitems, F const& func) const; // run func(index) for each item on the pool
       void fitIteration(FitStatus& status, MConfig const& mconfig);
       bool canIterate() const;
       bool oscillating(FitStatus const& status, MConfig const& mconfig) const;
-      void createBFCorr();
+      void createBFCorr(TRange const& range);
+      void sortEffects();
+      void swapTraj();
       // payload
       KKCONFIGPTR kkconfig_; // shared configuration
-      std::vector<FitStatus> history_; // fit status history; records the current iteration
+      FSCOL history_; // fit status history; records the current iteration
       PKTRAJ reftraj_; // reference against which the derivatives were evaluated and the current fit performed
-      PKTRAJ fittraj_; // result of the current fit, becomes the reference when the fit is algebraically iterated
+      PKTRAJ fittraj_; // result of the current fit, swapped with the reference when the fit is algebraically iterated
+      bool newfit_; // true if fittraj_ has been rebuilt since it was last swapped to the reference
       KKEFFCOL effects_; // effects used in this fit, sorted by time
-      THITCOL thits_; // shared collection of hits
-      DXINGCOL dxings_; // shared collection of material crossings/interactions
+      THITREFS thits_; // shared collection of hits
+      DXINGREFS dxings_; // shared collection of material crossings/interactions
+      // destroy an object allocated from a memory resource, and return its memory
+      struct MResDeleter {
+	std::pmr::memory_resource* mres_ = nullptr;
+	template <class T> void operator()(T* obj) const {
+	  obj->~T();
+	  std::pmr::polymorphic_allocator<T>(mres_).deallocate(obj,1);
+	}
+      };
+      std::unique_ptr<BFieldCache,MResDeleter> bfcache_; // field samples along this track, shared by the BField effects
   };
 
 // construct from configuration, reference (seed) fit, hits,and materials specific to this fit.  Note that hits
 // can contain associated materials.
-  template <class KTRAJ> KKTrk<KTRAJ>::KKTrk(KKCONFIGPTR const& kkconfig, PKTRAJ const& reftraj,  THITCOL& thits, DXINGCOL& dxings) : 
-    kkconfig_(kkconfig), reftraj_(reftraj), thits_(thits), dxings_(dxings) {
+  template <class KTRAJ> KKTrk<KTRAJ>::KKTrk(KKCONFIGPTR const& kkconfig, PKTRAJ const& reftraj,  THITCOL& thits, DXINGCOL& dxings,
+      std::pmr::memory_resource* mres) : kkconfig_(kkconfig), history_(mres), reftraj_(reftraj,mres), fittraj_(mres), newfit_(false), effects_(mres),
+    thits_(thits.begin(),thits.end(),mres), dxings_(dxings.begin(),dxings.end(),mres) {
+      KKTRACE_SCOPE("KKTrk::KKTrk");
     // create the effects.  First, loop over the hits
-      for(auto& thit : thits_ ) {
-	// create the hit effects and insert them in the set
-	// if there's associated material, create a combined material and hit effect, otherwise just a hit effect
-	if(kkconfig_->addmat_ && thit->hasMaterial()){
-	  dxings_.push_back(thit->detCrossing());
-	  effects_.emplace_back(std::make_unique<KKMHIT>(thit,reftraj_));
-	} else{ 
-	  effects_.emplace_back(std::make_unique<KKHIT>(thit,reftraj_));
-	}
-      }
+      effects_.reserve(thits.size() + dxings.size() + 2);
+      for(auto& thit : thits_ ) createHitEffect(thit);
       //add pure material effects
       if(kkconfig_->addmat_){
 	for(auto& dxing : dxings) {
-	  effects_.emplace_back(std::make_unique<KKMAT>(dxing,reftraj_));
+	  effects_.emplace_back(std::in_place_type<KKMAT>,dxing,reftraj_);
 	}
       }
       // preliminary sort
-      std::sort(effects_.begin(),effects_.end(),KKEFFComp ());
+      sortEffects();
       // reset the range 
-      reftraj_.setRange(TRange(std::min(reftraj_.range().low(),effects_.begin()->get()->time() - config().tbuff_),
-	    std::max(reftraj_.range().high(),effects_.rbegin()->get()->time() + config().tbuff_)));
+      reftraj_.setRange(TRange(std::min(reftraj_.range().low(),effTime(effects_.front()) - config().tbuff_),
+	    std::max(reftraj_.range().high(),effTime(effects_.back()) + config().tbuff_)));
       // add BField inhomogeneity effects
       if(kkconfig_->addbf_) {
-	createBFCorr();
+	// allocate the cache from the fit's memory resource; it lives at a fixed address, as the effects reference it
+	std::pmr::polymorphic_allocator<BFieldCache> alloc(mres);
+	BFieldCache* bfcache = alloc.allocate(1);
+	try {
+	  alloc.construct(bfcache,kkconfig_->bfield_,kkconfig_->bcachetol_,mres);
+	} catch (...) {
+	  alloc.deallocate(bfcache,1);
+	  throw;
+	}
+	bfcache_ = std::unique_ptr<BFieldCache,MResDeleter>(bfcache,MResDeleter{mres});
+	createBFCorr(reftraj_.range());
       }
       // create end effects; this should be last to avoid confusing the BField correction
-      effects_.emplace_back(std::make_unique<KKEND>(reftraj,TDir::forwards,config().dwt_));
-      effects_.emplace_back(std::make_unique<KKEND>(reftraj,TDir::backwards,config().dwt_));
+      effects_.emplace_back(std::in_place_type<KKEND>,reftraj,TDir::forwards,config().dwt_);
+      effects_.emplace_back(std::in_place_type<KKEND>,reftraj,TDir::backwards,config().dwt_);
       // now fit the track
+      history_.reserve(config().schedule().size()*(config().maxniter_+1));
       fit();
       if(kkconfig_->plevel_ > KKConfig::none)print(std::cout, kkconfig_->plevel_);
     }
 
   // fit iteration management 
   template <class KTRAJ> void KKTrk<KTRAJ>::fit() {
+    fit(config().schedule().begin(),config().schedule().end(),0);
+  }
+
+  template <class KTRAJ> void KKTrk<KTRAJ>::fit(typename MCONFIGCOL::const_iterator first, typename MCONFIGCOL::const_iterator last, int miter0) {
+    KKTRACE_SCOPE("KKTrk::fit");
    // execute the schedule of meta-iterations
-    for(auto imconfig=config().schedule().begin(); imconfig != config().schedule().end(); imconfig++){
+    for(auto imconfig=first; imconfig != last; imconfig++){
       auto mconfig  = *imconfig;
-      mconfig.miter_  = std::distance(config().schedule().begin(),imconfig);
+      mconfig.miter_  = miter0 + std::distance(first,imconfig);
+      KKTRACE_SCOPE("meta-iteration",mconfig.miter_);
+      // if only the temperature changed since the previous meta-iteration, and that converged, the effects are still
+      // linearized about a trajectory close to the fit, so they can just be rescaled
+      bool rescale = kkconfig_->rescaletemp_ && imconfig != first && newfit_ && fitStatus().status_ == FitStatus::converged &&
+	mconfig.tempOnly(*std::prev(imconfig));
       // algebraic convergence iteration
       FitStatus fstat(mconfig.miter_);
       history_.push_back(fstat);
       if(kkconfig_->plevel_ >= KKConfig::basic)std::cout << "Processing fit meta-iteration " << mconfig << std::endl;
       while(canIterate()) {
+#ifdef KINKAL_FITSTATS
+	FitStats start = FitStats::threadTotals();
+#endif
 	// catch exceptions and record them in the status
 	try {
-	  update(fstat,mconfig);
+	  update(fstat,mconfig,rescale);
 	  fitIteration(fstat,mconfig);
 	} catch (std::exception const& error) {
 	  fstat.status_ = FitStatus::failed;
 	  fstat.comment_ = error.what();
 	}
+#ifdef KINKAL_FITSTATS
+	fstat.stats_ = FitStats::threadTotals() - start;
+	fstat.mstats_ += fstat.stats_;
+#endif
 	// record this status in the history
 	history_.push_back(fstat);
       }
     }
   }
 
+  template <class KTRAJ> unsigned KKTrk<KTRAJ>::addHits(THITCOL const& thits, MCONFIGCOL const& schedule) {
+    KKTRACE_SCOPE("KKTrk::addHits");
+    // the new effects are built against the most recent fit, which becomes the reference for the refit
+    swapTraj();
+    thits_.reserve(thits_.size() + thits.size());
+    unsigned nadded(0);
+    for(auto const& thit : thits) {
+      // a hit can only contribute once
+      if(std::find(thits_.begin(),thits_.end(),thit) != thits_.end()) continue;
+      // if the hit's material is already in the fit (ie the hit was removed), the combined effect replaces it
+      if(kkconfig_->addmat_ && thit->hasMaterial()){
+	auto imat = std::find_if(effects_.begin(),effects_.end(),[&thit](KKEFFV const& effv) {
+	    auto kkmat = std::get_if<KKMAT>(&effv);
+	    return kkmat != 0 && kkmat->detXing() == thit->detCrossing(); });
+	if(imat != effects_.end()){
+	  effects_.erase(imat);
+	  auto idxing = std::find(dxings_.begin(),dxings_.end(),thit->detCrossing());
+	  if(idxing != dxings_.end()) dxings_.erase(idxing);
+	}
+      }
+      thits_.push_back(thit);
+      createHitEffect(thit);
+      nadded++;
+    }
+    if(nadded > 0){
+      sortEffects();
+      extendRange();
+      refit(schedule);
+    }
+    return nadded;
+  }
+
+  template <class KTRAJ> bool KKTrk<KTRAJ>::removeHit(THITPTR const& thit, MCONFIGCOL const& schedule) {
+    KKTRACE_SCOPE("KKTrk::removeHit");
+    auto ithit = std::find(thits_.begin(),thits_.end(),thit);
+    if(ithit == thits_.end()) return false;
+    THITPTR rhit(thit); // the argument may refer to our own hit collection
+    thits_.erase(ithit);
+    auto ieff = std::find_if(effects_.begin(),effects_.end(),[&rhit](KKEFFV const& effv) {
+	if(auto kkhit = std::get_if<KKHIT>(&effv)) return kkhit->tHit() == rhit;
+	if(auto kkmhit = std::get_if<KKMHIT>(&effv)) return kkmhit->hit().tHit() == rhit;
+	return false; });
+    if(ieff != effects_.end()){
+      if(std::holds_alternative<KKMHIT>(*ieff)){
+	// the particle still crosses the hit's material: replace the combined effect with a material effect, built
+	// against the most recent fit like added effects.  Its time is the crossing time, so re-sort
+	swapTraj();
+	ieff->template emplace<KKMAT>(rhit->detCrossing(),reftraj_);
+	sortEffects();
+      } else
+	effects_.erase(ieff); // erasing keeps the other effects in time order
+    }
+    refit(schedule);
+    return true;
+  }
+
+  template <class KTRAJ> void KKTrk<KTRAJ>::refit(MCONFIGCOL const& schedule) {
+    // continue the meta-iteration numbering of the history, so that the first refit iteration starts from the current fit
+    int miter0 = history_.empty() ? 0 : history_.back().miter_+1;
+    if(!schedule.empty())
+      fit(schedule.begin(),schedule.end(),miter0);
+    else if(!config().schedule().empty())
+      fit(std::prev(config().schedule().end()),config().schedule().end(),miter0);
+    if(kkconfig_->plevel_ > KKConfig::none)print(std::cout, kkconfig_->plevel_);
+  }
+
+  template <class KTRAJ> unsigned KKTrk<KTRAJ>::resolveHits(HitResolution const& hres, MCONFIGCOL const& schedule) {
+    KKTRACE_SCOPE("KKTrk::resolveHits");
+    // the weight caches are consistent with the reference only if the last iteration completed
+    if(!newfit_ || !fitStatus().usable() || config().schedule().empty()) return 0;
+    std::vector<KKHIT const*> kkhits;
+    for(auto const& ieff : effects_){
+      if(auto kkhit = std::get_if<KKHIT>(&ieff))
+	kkhits.push_back(kkhit);
+      else if(auto kkmhit = std::get_if<KKMHIT>(&ieff))
+	kkhits.push_back(&kkmhit->hit());
+    }
+    // evaluate each hit against its unbiased parameters.  Removing a hit reduces the chisquared by its unbiased chisquared,
+    // switching its state by the difference with the alternative.  The hits are independent, so are evaluated as one batch
+    struct Change { double dchisq_; bool flip_; };
+    std::vector<Change> changes(kkhits.size(),Change{0.0,false});
+    double maxchisq = hres.maxchi_*hres.maxchi_;
+    auto evaluate = [&](size_t ihit) {
+      PDATA unbiased;
+      if(!kkhits[ihit]->unbiasedParams(unbiased)) return;
+      double chisq = kkhits[ihit]->chisq(unbiased);
+      double altchi;
+      if(kkhits[ihit]->altChi(unbiased,altchi) && chisq - altchi*altchi > hres.minflip_ && altchi*altchi < maxchisq)
+	changes[ihit] = Change{chisq - altchi*altchi,true};
+      else if(chisq > maxchisq)
+	changes[ihit] = Change{chisq,false};
+    };
+    if(parallel())
+      runBlocks("resolve hits",kkhits.size(),evaluate);
+    else
+      for(size_t ihit=0;ihit < kkhits.size(); ihit++) evaluate(ihit);
+    // apply the largest reductions first, without deactivating so many hits that the fit would be underconstrained
+    std::vector<size_t> icands;
+    for(size_t ihit=0;ihit < kkhits.size(); ihit++) if(changes[ihit].dchisq_ > 0.0) icands.push_back(ihit);
+    std::sort(icands.begin(),icands.end(),[&changes](size_t a, size_t b) { return changes[a].dchisq_ > changes[b].dchisq_; });
+    int ndof = fitStatus().ndof_;
+    unsigned nchange(0);
+    for(auto ihit : icands){
+      if(nchange >= hres.maxchange_) break;
+      auto const& thit = kkhits[ihit]->tHit();
+      if(changes[ihit].flip_)
+	thit->useAlt();
+      else if(ndof - (int)kkhits[ihit]->nDOF() >= (int)config().minndof_){
+	ndof -= kkhits[ihit]->nDOF();
+	thit->setActivity(false);
+      } else
+	continue;
+      nchange++;
+    }
+    if(nchange > 0){
+      // refit without updating the hits, as that would override these changes
+      MCONFIGCOL rschedule = schedule.empty() ? MCONFIGCOL(1,config().schedule().back()) : schedule;
+      for(auto& mconfig : rschedule) mconfig.updatehits_ = false;
+      refit(rschedule);
+    }
+    return nchange;
+  }
+
+  // create the effect for a hit: if there's associated material, a combined material and hit effect, otherwise just a hit effect
+  template <class KTRAJ> void KKTrk<KTRAJ>::createHitEffect(THITPTR const& thit) {
+    thit->setTPocaLimits(kkconfig_->tplimits_);
+    if(kkconfig_->addmat_ && thit->hasMaterial()){
+      dxings_.push_back(thit->detCrossing());
+      effects_.emplace_back(std::in_place_type<KKMHIT>,thit,reftraj_);
+    } else{ 
+      effects_.emplace_back(std::in_place_type<KKHIT>,thit,reftraj_);
+    }
+  }
+
+  // extend the reference range, and the BField corrections, to cover effects added past the ends of the fit
+  template <class KTRAJ> void KKTrk<KTRAJ>::extendRange() {
+    TRange erange(std::min(reftraj_.range().low(),effTime(*std::next(effects_.begin())) - config().tbuff_),
+	std::max(reftraj_.range().high(),effTime(*std::next(effects_.rbegin())) + config().tbuff_));
+    if(erange.low() < reftraj_.range().low() || erange.high() > reftraj_.range().high()) reftraj_.setRange(erange);
+    if(bfcache_){
+      // the BField domains are contiguous, so the existing ones cover from the first to the last
+      auto isbf = [](KKEFFV const& effv) { return std::holds_alternative<KKBFIELD>(effv); };
+      auto fbf = std::find_if(effects_.begin(),effects_.end(),isbf);
+      if(fbf == effects_.end())
+	createBFCorr(erange);
+      else {
+	double blow = std::get<KKBFIELD>(*fbf).range().low();
+	double bhigh = std::get<KKBFIELD>(*std::find_if(effects_.rbegin(),effects_.rend(),isbf)).range().high();
+	if(erange.low() < blow) createBFCorr(TRange(erange.low(),blow));
+	if(erange.high() > bhigh) createBFCorr(TRange(bhigh,erange.high()));
+      }
+      sortEffects();
+    }
+  }
+
   // single algebraic iteration 
   template <class KTRAJ> void KKTrk<KTRAJ>::fitIteration(FitStatus& fstat, MConfig const& mconfig) {
     if(kkconfig_->plevel_ >= KKConfig::complete)std::cout << "Processing fit iteration " << fstat.iter_ << std::endl;
@@ -187,44 +417,34 @@ namespace KinKal {
     fstat.chisq_ = 0.0;
     fstat.ndof_ = -(int)KTRAJ::NParams();
     fstat.iter_++;
-    // fit in both directions (order doesn't matter)
-    auto feff = effects_.begin();
-    // start with empty fit information; each effect will modify this as necessary, and cache what it needs for later processing
-    KKData<KTRAJ::NParams()> ffitdata;
-    while(feff != effects_.end()){
-      auto ieff = feff->get();
-      // update chisquared; only needed forwards
-      fstat.ndof_ += ieff->nDOF();
-      double dchisq = ieff->chisq(ffitdata.pData());
-      fstat.chisq_ += dchisq;
-      // process
-      ieff->process(ffitdata,TDir::forwards);
-      if(kkconfig_->plevel_ >= KKConfig::detailed){
-	std::cout << "Chisq total " << fstat.chisq_ << " increment " << dchisq << " ";
-	ieff->print(std::cout,kkconfig_->plevel_);
-      }
-      feff++;
+    KKTRACE_SCOPE("KKTrk::fitIteration",fstat.iter_);
+    // fit in both directions.  The order doesn't matter, and the effects keep separate state for each direction, so
+    // the sweeps can run concurrently
+    if(kkconfig_->parsweep_ && parallel()){
+      WorkStealingPool::TASKCOL tasks;
+      tasks.emplace_back([this,&fstat]() { forwardSweep(fstat); });
+      tasks.emplace_back([this]() { backwardSweep(); });
+      runTasks(tasks);
+    } else {
+      forwardSweep(fstat);
+      backwardSweep();
     }
     fstat.prob_ = TMath::Prob(fstat.chisq_,fstat.ndof_);
-    // reset the fit information and process backwards (the order does not matter)
-    KKData<KTRAJ::NParams()> bfitdata;
-    auto beff = effects_.rbegin();
-    while(beff != effects_.rend()){
-      auto ieff = beff->get();
-      ieff->process(bfitdata,TDir::backwards);
-      beff++;
-    }
-    // convert the fit result into a new trajectory; start with an empty ptraj
-    fittraj_ = PKTRAJ();
-    // process forwards, adding pieces as necessary
-    for(auto& ieff : effects_) {
-      ieff->append(fittraj_);
+    KKSTAT_TIMER(timer);
+    {
+      KKTRACE_SCOPE("append");
+      // convert the fit result into a new trajectory.  This reuses the storage of the previous reference
+      fittraj_.clear();
+      newfit_ = true;
+      // process forwards, adding pieces as necessary
+      for(auto& ieff : effects_) {
+	std::visit([this](auto& eff) { eff.append(fittraj_); }, ieff);
+      }
+      // trim the range to the physical elements (past the end sites)
+      fittraj_.front().range().low() = effTime(*std::next(effects_.begin())) - config().tbuff_;
+      fittraj_.back().range().high() = effTime(*std::next(effects_.rbegin())) + config().tbuff_;
     }
-    // trim the range to the physical elements (past the end sites)
-    feff = effects_.begin(); feff++;
-    beff = effects_.rbegin(); beff++;
-    fittraj_.front().range().low() = (*feff)->time() - config().tbuff_;
-    fittraj_.back().range().high() = (*beff)->time() + config().tbuff_;
+    KKSTAT_LAP(timer,tappend_);
     // update status.  Convergence criteria is iteration-dependent
     double dchisq = (fstat.chisq_ -fitStatus().chisq_)/fstat.ndof_;
     if (fstat.ndof_ < config().minndof_){
@@ -239,20 +459,137 @@ namespace KinKal {
       fstat.status_ = FitStatus::unconverged;
   }
 
+  template <class KTRAJ> void KKTrk<KTRAJ>::forwardSweep(FitStatus& fstat) {
+    KKTRACE_SCOPE("forward sweep");
+    KKSTAT_TIMER(timer);
+    // start with empty fit information; each effect will modify this as necessary, and cache what it needs for later processing
+    KKData<KTRAJ::NParams()> ffitdata;
+    for(auto& feff : effects_){
+      std::visit([&](auto& ieff) {
+	  // update chisquared; only needed forwards
+	  fstat.ndof_ += ieff.nDOF();
+	  double dchisq = ieff.chisq(ffitdata.pData());
+	  fstat.chisq_ += dchisq;
+	  // process
+	  ieff.process(ffitdata,TDir::forwards);
+	  if(kkconfig_->plevel_ >= KKConfig::detailed){
+	    std::cout << "Chisq total " << fstat.chisq_ << " increment " << dchisq << " ";
+	    ieff.print(std::cout,kkconfig_->plevel_);
+	  }
+	}, feff);
+    }
+    KKSTAT_LAP(timer,tforward_);
+  }
+
+  template <class KTRAJ> void KKTrk<KTRAJ>::backwardSweep() {
+    KKTRACE_SCOPE("backward sweep");
+    KKSTAT_TIMER(timer);
+    KKData<KTRAJ::NParams()> bfitdata;
+    for(auto beff = effects_.rbegin(); beff != effects_.rend(); beff++)
+      std::visit([&bfitdata](auto& ieff) { ieff.process(bfitdata,TDir::backwards); }, *beff);
+    KKSTAT_LAP(timer,tbackward_);
+  }
+
   // update between iterations 
-  template <class KTRAJ> void KKTrk<KTRAJ>::update(FitStatus const& fstat, MConfig const& mconfig) {
-    if(fstat.iter_ < 0) { // 1st iteration of a meta-iteration: update the state
+  template <class KTRAJ> void KKTrk<KTRAJ>::update(FitStatus const& fstat, MConfig const& mconfig, bool rescale) {
+    KKTRACE_SCOPE("KKTrk::update");
+    KKSTAT_TIMER(timer);
+    if(fstat.iter_ < 0 && rescale) { // 1st iteration of a temperature-only meta-iteration: keep the reference
+      for(auto& ieff : effects_)
+	std::visit([&mconfig](auto& eff) { eff.updateTemp(mconfig); }, ieff);
+    } else if(fstat.iter_ < 0) { // 1st iteration of a meta-iteration: update the state
       if(mconfig.miter_ > 0)// if this isn't the 1st meta-iteration, swap the fit trajectory to the reference
-	reftraj_ = fittraj_;
-      for(auto& ieff : effects_ ) ieff->update(reftraj_,mconfig);
+	swapTraj();
+      updateEffects(&mconfig);
     } else {
       //swap the fit trajectory to the reference
-      reftraj_ = fittraj_;
+      swapTraj();
       // update the effects to use the new reference
-      for(auto& ieff : effects_) ieff->update(reftraj_);
+      updateEffects(0);
     }
     // sort the effects by time
-    std::sort(effects_.begin(),effects_.end(),KKEFFComp ());
+    sortEffects();
+    KKSTAT_LAP(timer,tupdate_);
+  }
+
+  // update the effects to the reference trajectory, and to the meta-iteration configuration if given.  The effects
+  // depend only on the (const) reference and their own state, so large tracks can be updated concurrently
+  template <class KTRAJ> void KKTrk<KTRAJ>::updateEffects(MConfig const* mconfig) {
+    double tol = kkconfig_->reftol_;
+    auto updateEff = [this,mconfig,tol](KKEFFV& effv) {
+      std::visit([this,mconfig,tol](auto& eff) {
+	  if(mconfig)
+	    eff.update(reftraj_,*mconfig);
+	  else if(tol > 0.0)
+	    eff.approxUpdate(reftraj_,tol);
+	  else
+	    eff.update(reftraj_);
+	  }, effv); };
+    if(!parallel()){
+      for(auto& ieff : effects_) updateEff(ieff);
+      return;
+    }
+    // The BField effects share this track's field cache, which isn't thread-safe, so they are updated afterwards on this thread
+    runBlocks("parallel update",effects_.size(),[&](size_t ieff) {
+	if(!std::holds_alternative<KKBFIELD>(effects_[ieff])) updateEff(effects_[ieff]); });
+    for(auto& ieff : effects_)
+      if(std::holds_alternative<KKBFIELD>(ieff)) updateEff(ieff);
+  }
+
+  template <class KTRAJ> bool KKTrk<KTRAJ>::parallel() const {
+    return kkconfig_->pool_ && kkconfig_->pool_->nThreads() > 1 && effects_.size() >= kkconfig_->minpareff_;
+  }
+
+  template <class KTRAJ> template <class F> void KKTrk<KTRAJ>::runBlocks(const char* name, size_t nitems, F const& func) const {
+    // divide the items into contiguous blocks, several per thread to balance the load
+    size_t ntasks = std::min(nitems,size_t(4*kkconfig_->pool_->nThreads()));
+    WorkStealingPool::TASKCOL tasks;
+    tasks.reserve(ntasks);
+    for(size_t itask=0;itask < ntasks; itask++){
+      tasks.emplace_back([&,itask]() {
+	  KKTRACE_SCOPE(name,itask);
+	  for(size_t item = itask*nitems/ntasks; item < (itask+1)*nitems/ntasks; item++) func(item);
+	  });
+    }
+    runTasks(tasks);
+  }
+
+  template <class KTRAJ> void KKTrk<KTRAJ>::runTasks(WorkStealingPool::TASKCOL& tasks) const {
+#ifdef KINKAL_FITSTATS
+    // move the counts from the threads running the tasks to this one
+    std::vector<FitStats> tstats(tasks.size());
+    for(size_t itask=0;itask < tasks.size(); itask++){
+      tasks[itask] = [task=std::move(tasks[itask]),&stats=tstats[itask]]() {
+	FitStats start = FitStats::threadTotals();
+	task();
+	stats = FitStats::threadTotals() - start;
+	FitStats::threadTotals() = start;
+      };
+    }
+#endif
+    kkconfig_->pool_->run(tasks);
+#ifdef KINKAL_FITSTATS
+    for(auto const& stats : tstats) FitStats::threadTotals() += stats;
+#endif
+  }
+
+  template <class KTRAJ> void KKTrk<KTRAJ>::swapTraj() {
+    // the fit becomes the reference, and the old reference storage is recycled for the next fit.  If the last
+    // iteration failed before rebuilding the fit, the reference is already the most recent fit
+    if(newfit_){
+      reftraj_.swap(fittraj_);
+      newfit_ = false;
+    }
+  }
+
+  template <class KTRAJ> void KKTrk<KTRAJ>::sortEffects() {
+    // effects are stored by value, so avoid moving them unless the order actually changed.  Updates only
+    // move effects locally, so re-insert just the out-of-order effects
+    auto ieff = std::is_sorted_until(effects_.begin(),effects_.end(),KKEFFComp());
+    while(ieff != effects_.end()){
+      std::rotate(std::upper_bound(effects_.begin(),ieff,*ieff,KKEFFComp()),ieff,std::next(ieff));
+      ieff = std::is_sorted_until(ieff,effects_.end(),KKEFFComp());
+    }
   }
 
   template<class KTRAJ> bool KKTrk<KTRAJ>::canIterate() const {
@@ -269,18 +606,18 @@ namespace KinKal {
     return false;
   }
 
-  template <class KTRAJ> void KKTrk<KTRAJ>::createBFCorr() {
+  template <class KTRAJ> void KKTrk<KTRAJ>::createBFCorr(TRange const& range) {
     // Should allow local field tracking option eventually FIXME!
     // start at the low end of the range
-    TRange drange(reftraj_.range().low(),reftraj_.range().low());
+    TRange drange(range.low(),range.low());
     // advance until the range is exhausted
-    while(drange.high() < reftraj_.range().high()){
+    while(drange.high() < range.high()){
       // find how far we can advance within tolerance
-      reftraj_.rangeInTolerance(drange,kkconfig_->bfield_,kkconfig_->tol_);
+      reftraj_.rangeInTolerance(drange,*bfcache_,kkconfig_->tol_);
       // truncate if necessary
-      drange.high() = std::min(drange.high(),reftraj_.range().high());
+      drange.high() = std::min(drange.high(),range.high());
       // create the BField effect for this drange
-      effects_.emplace_back(std::make_unique<KKBFIELD>(kkconfig_->bfield_,reftraj_,drange));
+      effects_.emplace_back(std::in_place_type<KKBFIELD>,*bfcache_,reftraj_,drange,kkconfig_->btol_);
       drange.low() = drange.high();
     }
   }
@@ -301,7 +638,7 @@ namespace KinKal {
     }
     if(detail > 2) {
       ost << " Effects " << endl;
-      for(auto const& eff : effects()) eff.get()->print(ost,detail-3);
+      for(auto const& eff : effects()) effect(eff).print(ost,detail-3);
     }
   }
 
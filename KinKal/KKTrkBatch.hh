@@ -0,0 +1,76 @@
+#ifndef KinKal_KKTrkBatch_hh
+#define KinKal_KKTrkBatch_hh
+//
+//  Fit a batch of tracks concurrently.  Each track is described by a seed trajectory and a unique set of
+//  hits and material crossings; all the tracks share the same configuration.  The fits are run as tasks on a
+//  work-stealing thread pool, ordered by decreasing number of hits so the most expensive fits start first.
+//  The fit results are returned in the order the tracks were added to the batch.
+//  Objects shared between the fits (BField, materials, straw geometry, ...) are accessed concurrently through
+//  const interfaces, and so must be safe for that.
+//
+#include "KinKal/KKTrk.hh"
+#include "KinKal/WorkStealingPool.hh"
+#include <vector>
+#include <memory>
+#include <numeric>
+#include <algorithm>
+
+namespace KinKal {
+  template<class KTRAJ> class KKTrkBatch {
+    public:
+      typedef KKTrk<KTRAJ> KKTRK;
+      typedef std::unique_ptr<KKTRK> KKTRKPTR;
+      typedef std::vector<KKTRKPTR> KKTRKCOL;
+      typedef typename KKTRK::KKCONFIGPTR KKCONFIGPTR;
+      typedef typename KKTRK::PKTRAJ PKTRAJ;
+      typedef typename KKTRK::THITCOL THITCOL;
+      typedef typename KKTRK::DXINGCOL DXINGCOL;
+      typedef std::shared_ptr<WorkStealingPool> POOLPTR;
+      // construct from the shared configuration and the pool to run the fits on
+      KKTrkBatch(KKCONFIGPTR const& kkconfig, POOLPTR const& pool) : kkconfig_(kkconfig), pool_(pool) {}
+      // add a track to the batch.  The return value is its index in the fit results
+      size_t addTrack(PKTRAJ const& seed, THITCOL const& thits, DXINGCOL const& dxings) {
+	inputs_.emplace_back(seed,thits,dxings);
+	return inputs_.size()-1;
+      }
+      // fit all the tracks added since the last call, returning the fits in the order the tracks were added.
+      // If any fit throws the first exception is rethrown after all the fits have finished
+      KKTRKCOL fit();
+      // accessors
+      size_t nTracks() const { return inputs_.size(); }
+      KKConfig const& config() const { return *kkconfig_; }
+      WorkStealingPool& pool() const { return *pool_; }
+    private:
+      struct TrkInput {
+	PKTRAJ seed_;
+	THITCOL thits_;
+	DXINGCOL dxings_;
+	TrkInput(PKTRAJ const& seed, THITCOL const& thits, DXINGCOL const& dxings) : seed_(seed), thits_(thits), dxings_(dxings) {}
+      };
+      KKCONFIGPTR kkconfig_; // shared configuration
+      POOLPTR pool_; // thread pool, possibly shared with other users
+      std::vector<TrkInput> inputs_; // tracks waiting to be fit
+  };
+
+  template <class KTRAJ> typename KKTrkBatch<KTRAJ>::KKTRKCOL KKTrkBatch<KTRAJ>::fit() {
+    auto inputs = std::move(inputs_);
+    inputs_.clear();
+    KKTRKCOL fits(inputs.size());
+    // balance the load by starting the tracks with the most hits first
+    std::vector<size_t> order(inputs.size());
+    std::iota(order.begin(),order.end(),0);
+    std::stable_sort(order.begin(),order.end(),[&inputs](size_t i1, size_t i2) {
+	return inputs[i1].thits_.size() > inputs[i2].thits_.size(); });
+    WorkStealingPool::TASKCOL tasks;
+    tasks.reserve(order.size());
+    for(auto itrk : order) {
+      tasks.emplace_back([this,&inputs,&fits,itrk]() {
+	  auto& input = inputs[itrk];
+	  fits[itrk] = std::make_unique<KKTRK>(kkconfig_,input.seed_,input.thits_,input.dxings_);
+	  });
+    }
+    pool_->run(tasks);
+    return fits;
+  }
+}
+#endif
@@ -174,11 +174,12 @@ namespace KinKal {
     double sfac = spd*spd/(bn*pbar());
     // estimate step size from initial BField difference
     Vec3 tpos = position(drange.low());
-    Vec3 bvec = bfield.fieldVect(tpos);
+    Vec3 bvec = bfield.sampleField(drange.low(),tpos);
     auto db = (bvec - bnom_).R();
     double tstep(0.1);
     // this next part should have the hard-coded numbers replaced by parameters.  Some calculations should move to BField FIXME!
     if(db > 1e-4) tstep = 0.2*sqrt(tol/(sfac*db)); // step increment from difference from nominal
+    KKSTAT_COUNT(nbfield_,1);
     Vec3 dBdt = bfield.fieldDeriv(tpos,velocity(drange.low()));
     tstep = std::min(tstep, 0.5*cbrt(tol/(sfac*dBdt.R())));
     //
@@ -191,7 +192,7 @@ namespace KinKal {
       // increment the range
       drange.high() += tstep;
       tpos = position(drange.high());
-      bvec = bfield.fieldVect(tpos);
+      bvec = bfield.sampleField(drange.high(),tpos);
       // BField diff with nominal
       auto db = (bvec - bnom_).R();
       // spatial distortion accumulation
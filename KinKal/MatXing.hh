@@ -4,14 +4,37 @@
 //  Struct to describe a path crossing a piece of material
 //
 #include "MatEnv/DetMaterial.hh"
-#include <vector>
+#include <type_traits>
+#include <new>
+#include <stdexcept>
+#include <cstddef>
 namespace KinKal {
   struct MatXing {
     MatEnv::DetMaterial const& dmat_; // material
     double plen_; // path length through this material
     MatXing(MatEnv::DetMaterial const& dmat,double plen) : dmat_(dmat), plen_(plen) {}
   };
-  typedef std::vector<MatXing> MatXingCol;
+  // crossings of a single detector piece.  These are stored inline with a fixed capacity, so refilling them
+  // never allocates
+  class MatXingCol {
+    public:
+      static constexpr size_t maxXings = 4; // maximum number of materials crossed in 1 detector piece
+      MatXingCol() : nxings_(0) {}
+      void push_back(MatXing const& mxing) {
+	if(nxings_ == maxXings) throw std::length_error("MatXingCol: too many material crossings");
+	new (&data_[nxings_++]) MatXing(mxing);
+      }
+      void clear() { nxings_ = 0; }
+      size_t size() const { return nxings_; }
+      bool empty() const { return nxings_ == 0; }
+      MatXing const& operator [] (size_t ixing) const { return begin()[ixing]; }
+      MatXing const* begin() const { return std::launder(reinterpret_cast<MatXing const*>(data_)); }
+      MatXing const* end() const { return begin() + nxings_; }
+    private:
+      static_assert(std::is_trivially_copyable<MatXing>::value && std::is_trivially_destructible<MatXing>::value,
+	  "MatXing must be trivial to be stored inline");
+      typename std::aligned_storage<sizeof(MatXing),alignof(MatXing)>::type data_[maxXings];
+      size_t nxings_;
+  };
 }
 #endif
-
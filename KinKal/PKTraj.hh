@@ -18,6 +18,9 @@ namespace KinKal {
       // construct from an initial piece, which also provides kinematic information
       PKTraj(KTRAJ const& piece) : PTTRAJ(piece) {}
       PKTraj() : PTTRAJ() {}
+      typedef typename PTTRAJ::allocator_type allocator_type;
+      explicit PKTraj(allocator_type const& alloc) : PTTRAJ(alloc) {}
+      PKTraj(PKTraj const& other, allocator_type const& alloc) : PTTRAJ(other,alloc) {}
       //  append and prepend to check mass and charge consistency
       void append(KTRAJ const& newpiece, bool allowremove=false)  {
 	if(PTTRAJ::pieces().size() > 0){
@@ -2,22 +2,29 @@
 #define KinKal_PTTraj_hh
 //
 //  class describing a piecewise trajectory.  Templated on a simple time-based trajectory
-//  used as part of the kinematic kalman fit
+//  used as part of the kinematic kalman fit.  The pieces are stored contiguously and allocated through a polymorphic
+//  memory resource, so that fit-scope trajectories can use an arena (see KKArena).  Note that adding pieces can
+//  invalidate references to existing pieces.  clear() keeps the storage, so a trajectory that is repeatedly
+//  rebuilt doesn't reallocate.  The times of the boundaries between pieces are kept in a separate array, so
+//  that finding the piece for a given time is a binary search over contiguous memory.
 //
 #include "KinKal/TDir.hh"
 #include "KinKal/Vectors.hh"
 #include "KinKal/LocalBasis.hh"
 #include "KinKal/TRange.hh"
-#include <deque>
+#include <vector>
+#include <memory_resource>
 #include <ostream>
 #include <stdexcept>
 #include <typeinfo>
+#include <algorithm>
 
 namespace KinKal {
   template <class TTRAJ> class PTTraj {
     public:
       constexpr static size_t NParams() { return TTRAJ::NParams(); }
-      typedef typename std::deque<TTRAJ> DTTRAJ;
+      typedef typename std::pmr::vector<TTRAJ> DTTRAJ;
+      typedef typename DTTRAJ::allocator_type allocator_type;
       // forward calls to the pieces 
       void position(Vec4& pos) const {nearestPiece(pos.T()).position(pos); }
       Vec3 position(double time) const { return nearestPiece(time).position(time); }
@@ -28,8 +35,15 @@ namespace KinKal {
       void setRange(TRange const& trange, bool trim=false);
 // construct without any content.  Any functions except append or prepend will throw in this state
       PTTraj() {}
+      explicit PTTraj(allocator_type const& alloc) : pieces_(alloc), thigh_(alloc) {}
+// copy using a specific memory resource
+      PTTraj(PTTraj const& other, allocator_type const& alloc) : pieces_(other.pieces_,alloc), thigh_(other.thigh_,alloc) {}
 // construct from an initial piece
       PTTraj(TTRAJ const& piece);
+// remove all the pieces, keeping the allocator and storage
+      void clear() { pieces_.clear(); thigh_.clear(); }
+// exchange content with another trajectory.  This doesn't copy any pieces if both use the same memory resource
+      void swap(PTTraj& other);
 // append or prepend a piece, at the time of the corresponding end of the new trajectory.  The last 
 // piece will be shortened or extended as necessary to keep time contiguous.
 // Optionally allow truncate existing pieces to accomodate this piece.
@@ -37,13 +51,16 @@ namespace KinKal {
       void append(TTRAJ const& newpiece, bool allowremove=false);
       void prepend(TTRAJ const& newpiece, bool allowremove=false);
       void add(TTRAJ const& newpiece, TDir tdir=TDir::forwards, bool allowremove=false);
-// Find the piece associated with a particular time
+// Find the piece associated with a particular time.  The versions with a hint first test the hinted piece and
+// its successor: passing the index found by the previous call makes a sequence of increasing-time queries O(1)
       TTRAJ const& nearestPiece(double time) const { return pieces_[nearestIndex(time)]; }
+      TTRAJ const& nearestPiece(double time, size_t& hint) const { hint = nearestIndex(time,hint); return pieces_[hint]; }
       TTRAJ const& front() const { return pieces_.front(); }
       TTRAJ const& back() const { return pieces_.back(); }
       TTRAJ& front() { return pieces_.front(); }
       TTRAJ& back() { return pieces_.back(); }
-      size_t nearestIndex(double time) const;
+      size_t nearestIndex(double time) const { return nearestIndex(time,pieces_.size()); }
+      size_t nearestIndex(double time, size_t hint) const;
       DTTRAJ const& pieces() const { return pieces_; }
       // test for spatial gaps
       double gap(size_t ihigh) const;
@@ -51,23 +68,43 @@ namespace KinKal {
       void print(std::ostream& ost, int detail) const ;
     private:
       DTTRAJ pieces_; // constituent pieces
+      std::pmr::vector<double> thigh_; // upper time of each piece except the last, for piece lookup
+      bool inPiece(double time, size_t ipiece) const { // test if time belongs to a piece, excluding the ends of the trajectory
+	return ipiece < pieces_.size() && (ipiece == 0 || time > thigh_[ipiece-1]) && (ipiece+1 == pieces_.size() || time <= thigh_[ipiece]); }
   };
 
   template <class TTRAJ> void PTTraj<TTRAJ>::setRange(TRange const& trange, bool trim) {
 // trim pieces as necessary
     if(trim){
-      while(pieces_.size() > 1 && trange.low() > pieces_.front().range().high() ) pieces_.pop_front();
-      while(pieces_.size() > 1 && trange.high() < pieces_.back().range().low() ) pieces_.pop_back();
+      while(pieces_.size() > 1 && trange.low() > pieces_.front().range().high() ) {
+	pieces_.erase(pieces_.begin());
+	thigh_.erase(thigh_.begin());
+      }
+      while(pieces_.size() > 1 && trange.high() < pieces_.back().range().low() ) {
+	pieces_.pop_back();
+	thigh_.pop_back();
+      }
     } else if(trange.low() > pieces_.front().range().high() || trange.high() < pieces_.back().range().low())
       throw std::invalid_argument("Invalid Range");
     // update piece range
     pieces_.front().setRange(TRange(trange.low(),pieces_.front().range().high()));
-    pieces_.back().setRange(TRange(pieces_.front().range().low(),trange.high()));
+    pieces_.back().setRange(TRange(pieces_.back().range().low(),trange.high()));
   }
 
   template <class TTRAJ> PTTraj<TTRAJ>::PTTraj(TTRAJ const& piece) : pieces_(1,piece)
   {}
 
+  template <class TTRAJ> void PTTraj<TTRAJ>::swap(PTTraj& other) {
+    if(pieces_.get_allocator() == other.pieces_.get_allocator()){
+      pieces_.swap(other.pieces_);
+      thigh_.swap(other.thigh_);
+    } else {
+      PTTraj temp(*this);
+      *this = other;
+      other = temp;
+    }
+  }
+
   template <class TTRAJ> void PTTraj<TTRAJ>::add(TTRAJ const& newpiece, TDir tdir, bool allowremove){
     switch (tdir) {
       case TDir::forwards:
@@ -89,25 +126,29 @@ namespace KinKal {
     } else {
       // if the new piece completely contains the existing pieces, overwrite or fail
       if(newpiece.range().contains(range())){
-	if(allowremove)
-	  *this = PTTraj(newpiece);
-	else
+	if(allowremove){
+	  clear();
+	  pieces_.push_back(newpiece);
+	} else
 	  throw std::invalid_argument("range overlap");
       } else {
 	// find the piece that needs to be modified
 	size_t ipiece = nearestIndex(newpiece.range().high());
 	// see if truncation is needed
 	if( allowremove){
-	  while(ipiece >0 ) 
-	    pieces_.pop_front();
-	  ipiece--;
+	  while(ipiece >0 ) {
+	    pieces_.erase(pieces_.begin());
+	    thigh_.erase(thigh_.begin());
+	    ipiece--;
+	  }
 	}
 	// if we're at the start, prepend
 	if(ipiece == 0){
 	  // update ranges and add the piece
 	  double tmin = std::min(newpiece.range().low(),pieces_.front().range().low());
 	  pieces_.front().range().low() = newpiece.range().high() +TRange::tbuff_; 
-	  pieces_.push_front(newpiece);
+	  pieces_.insert(pieces_.begin(),newpiece);
+	  thigh_.insert(thigh_.begin(),newpiece.range().high());
 	  pieces_.front().range().low() = tmin;
 	} else {
 	  throw std::invalid_argument("range error");
@@ -124,9 +165,10 @@ namespace KinKal {
     } else {
       // if the new piece completely contains the existing pieces, overwrite or fail
       if(newpiece.range().low() < range().low()){
-	if(allowremove)
-	  *this = PTTraj(newpiece);
-	else
+	if(allowremove){
+	  clear();
+	  pieces_.push_back(newpiece);
+	} else
 	  throw std::invalid_argument("range overlap");
       } else {
 	// find the piece that needs to be modified
@@ -135,6 +177,7 @@ namespace KinKal {
 	if( allowremove){
 	  while(ipiece < pieces_.size()-1) {
 	    pieces_.pop_back();
+	    thigh_.pop_back();
 	  }
 	}
 	// if we're at the end, append
@@ -144,6 +187,7 @@ namespace KinKal {
 	  double tmax = std::max(newpiece.range().high(),pieces_.back().range().high());
 	  // truncate the range of the current back to match with the start of the new piece.  Leave a buffer on the upper range to prevent overlap
 	  pieces_.back().range().high() = newpiece.range().low()-TRange::tbuff_;
+	  thigh_.push_back(pieces_.back().range().high());
 	  pieces_.push_back(newpiece);
 	  pieces_.back().range().high() = tmax;
 	} else {
@@ -153,22 +197,18 @@ namespace KinKal {
     }
   }
 
-  template <class TTRAJ> size_t PTTraj<TTRAJ>::nearestIndex(double time) const {
-    size_t retval;
+  template <class TTRAJ> size_t PTTraj<TTRAJ>::nearestIndex(double time, size_t hint) const {
     if(pieces_.empty())throw std::length_error("Empty PTTraj!");
-    if(time <= range().low()){
-      retval = 0;
-    } else if(time >= range().high()){
-      retval = pieces_.size()-1;
-    } else {
-      // scan
-      retval = 0;
-      while(retval < pieces_.size() && !pieces_[retval].range().inRange(time) && time > pieces_[retval].range().high()){
-	retval++;
-      }
-      if(retval == pieces_.size())throw std::range_error("Failed PTraj range search");
-    }
-    return retval;
+    if(time <= pieces_.front().range().low())
+      return 0;
+    else if(time >= pieces_.back().range().high())
+      return pieces_.size()-1;
+    else if(inPiece(time,hint))
+      return hint;
+    else if(inPiece(time,hint+1))
+      return hint+1;
+    else // the 1st piece ending at or after this time
+      return std::distance(thigh_.begin(),std::lower_bound(thigh_.begin(),thigh_.end(),time));
   }
 
   template <class TTRAJ> double PTTraj<TTRAJ>::gap(size_t ihigh) const {
@@ -36,7 +36,12 @@ namespace KinKal {
       double value() const { return value_; }
       double variance() const  { return var_; }
       DVEC const& dRdP() const { return dRdP_; }
+      DVEC const& dDdP() const { return dDdP_; }
+      DVEC const& dTdP() const { return dTdP_; }
       Residual(rdim dim, TPocaBase const& tpoca, double value, double var, DVEC const& dRdP) : dim_(dim), tpoca_(tpoca), value_(value), var_(var), dRdP_(dRdP) {}
+      // also keep the TPOCA derivatives, so the residual of an alternative hit state can be built without re-solving TPOCA
+      Residual(rdim dim, TPocaBase const& tpoca, double value, double var, DVEC const& dRdP, DVEC const& dDdP, DVEC const& dTdP) :
+	dim_(dim), tpoca_(tpoca), value_(value), var_(var), dRdP_(dRdP), dDdP_(dDdP), dTdP_(dTdP) {}
       Residual() : dim_(unknown), value_(0.0), var_(-1.0) {}
     private:
       rdim dim_; // dimension of this residual
@@ -44,6 +49,7 @@ namespace KinKal {
       double value_;  // value for this residual
       double var_; // estimated variance of the residual due to sensor measurement uncertainty ONLY
       DVEC dRdP_; // derivative of residual WRT the reference parameters
+      DVEC dDdP_, dTdP_; // derivatives of the TPOCA DOCA and time difference WRT the reference parameters, if set
   };
 
   template <size_t DDIM> std::ostream& operator <<(std::ostream& ost, Residual<DDIM> const& res) {
@@ -40,11 +40,13 @@ namespace KinKal {
   };
 
   template <class KTRAJ> void ScintHit<KTRAJ>::resid(PKTRAJ const& pktraj,  RESIDUAL& resid) const {
-    // compute TPOCA
-    TPocaHint tphint;
-    tphint.particleHint_ = true;
-    tphint.particleToca_ = saxis_.t0();
-    TPOCA tpoca(pktraj,saxis_,tphint);
+    // compute TPOCA, starting from the previous solution if there is one, otherwise the measurement time
+    TPocaHint tphint = resid.tPoca().hint();
+    if(!tphint.particleHint_){
+      tphint.particleHint_ = true;
+      tphint.particleToca_ = saxis_.t0();
+    }
+    TPOCA tpoca(pktraj,saxis_,tphint,THit<KTRAJ>::tpocaLimits());
  
     if(tpoca.usable()){
       // residual is just delta-T at POCA. 
@@ -4,6 +4,13 @@
 #include <stdexcept>
 
 namespace KinKal {
+  void StrawMat::docaRange(double doca, double ddoca, double& rdmin, double& rdmax) const {
+    // integrate +- 1 sigma from DOCA.  Restrict rmax to physical values
+    // Note that negative rdmin is handled naturally
+    rdmax = std::min(rdmax_,(doca+ddoca)/srad_);
+    rdmin = std::min(std::max(wrad_,doca-ddoca)/srad_,rdmax-thick_);
+  }
+
   double StrawMat::gasPath(double doca, double ddoca, double adot) const {
     doca = std::min(fabs(doca),srad_);
     double afac = 1.0/sqrt(1.0-adot*adot); // angle factor, =1.0/sin(theta)
@@ -12,12 +19,10 @@ namespace KinKal {
     double retval;
     if (ddoca < ddmax_) {  // small error: don't integrate
       double rad = std::min(doca,srad_-thick_);
-      retval = 2.0*sqrt(srad2_-rad*rad); 
-    } else { 
-      // integrate +- 1 sigma from DOCA.  Restrict rmax to physical values
-      // Note that negative rdmin is handled naturally
-      double rdmax = std::min(rdmax_,(doca+ddoca)/srad_);
-      double rdmin = std::min(std::max(wrad_,doca-ddoca)/srad_,rdmax-thick_);
+      retval = 2.0*sqrt(srad2_-rad*rad);
+    } else {
+      double rdmin, rdmax;
+      docaRange(doca,ddoca,rdmin,rdmax);
       retval = srad_*(asin(rdmax) - asin(rdmin) +
 	  rdmax*sqrt(1.0-rdmax*rdmax) - rdmin*sqrt(1.0-rdmin*rdmin) )/(rdmax-rdmin);
       if(isnan(retval))throw std::runtime_error("Invalid pathlength");
@@ -35,10 +40,8 @@ namespace KinKal {
       double rad = std::min(doca,srad_-thick_);
       retval = 2.0*thick_*srad_/sqrt(srad2_-rad*rad);
     } else {
-      // integrate +- 1 sigma from DOCA.  Restrict rmax to physical values
-      // Note that negative rdmin is handled naturally
-      double rdmax = std::min(rdmax_,(doca+ddoca)/srad_);
-      double rdmin = std::min(std::max(wrad_,doca-ddoca)/srad_,rdmax-thick_);
+      double rdmin, rdmax;
+      docaRange(doca,ddoca,rdmin,rdmax);
       retval = 2.0*thick_*(asin(rdmax) - asin(rdmin))/(rdmax-rdmin);
       if(isnan(retval))throw std::runtime_error("Invalid pathlength");
     }
@@ -47,11 +50,64 @@ namespace KinKal {
     return retval;
   }
 
-  void StrawMat::findXings(double doca, double ddoca, double adot, std::vector<MatXing>& mxings) const {
+  void StrawMat::fillTable() {
+    // cover the range docaRange can return when integrating
+    tabmin_ = std::max(-1.0,std::min(wrad_/srad_,std::min(rdmax_,ddmax_/srad_)-thick_));
+    tabstep_ = (rdmax_-tabmin_)/(ntab_-1);
+    ptab_.resize(ntab_);
+    for(size_t itab=0;itab<ntab_;itab++){
+      double rdoca = tabmin_ + itab*tabstep_;
+      double root = sqrt(1.0-rdoca*rdoca);
+      ptab_[itab] = {asin(rdoca) + rdoca*root, 2.0*root, asin(rdoca), 1.0/root};
+    }
+  }
+
+  void StrawMat::pathIntegrals(double rdoca, double& gint, double& wint) const {
+    double tpos = (rdoca-tabmin_)/tabstep_;
+    if(tpos >= 0.0 && tpos <= ntab_-1){
+      size_t itab = std::min(static_cast<size_t>(tpos),ntab_-2);
+      double tfrac = tpos - itab;
+      auto const& low = ptab_[itab];
+      auto const& high = ptab_[itab+1];
+      // cubic Hermite basis
+      double t2 = tfrac*tfrac, t3 = t2*tfrac;
+      double h00 = 2.0*t3 - 3.0*t2 + 1.0, h10 = tabstep_*(t3 - 2.0*t2 + tfrac);
+      double h01 = 3.0*t2 - 2.0*t3, h11 = tabstep_*(t3 - t2);
+      gint = h00*low[0] + h10*low[1] + h01*high[0] + h11*high[1];
+      wint = h00*low[2] + h10*low[3] + h01*high[2] + h11*high[3];
+    } else {
+      // outside the table (unusual geometry): compute directly
+      wint = asin(rdoca);
+      gint = wint + rdoca*sqrt(1.0-rdoca*rdoca);
+    }
+  }
+
+  void StrawMat::findXings(double doca, double ddoca, double adot, MatXingCol& mxings) const {
     mxings.clear();
-    double wpath = wallPath(doca,ddoca,adot);
+    doca = std::min(fabs(doca),srad_);
+    double afac = 1.0/sqrt(1.0-adot*adot); // angle factor, =1.0/sin(theta)
+    if(!isfinite(afac))throw std::runtime_error("Invalid angle");
+    double wpath, gpath;
+    if (ddoca < ddmax_) {  // small error: don't integrate
+      double rad = std::min(doca,srad_-thick_);
+      double chord = sqrt(srad2_-rad*rad);
+      wpath = 2.0*thick_*srad_/chord;
+      gpath = 2.0*chord;
+    } else {
+      double rdmin, rdmax;
+      docaRange(doca,ddoca,rdmin,rdmax);
+      double gmin, wmin, gmax, wmax;
+      pathIntegrals(rdmin,gmin,wmin);
+      pathIntegrals(rdmax,gmax,wmax);
+      double invrange = 1.0/(rdmax-rdmin);
+      wpath = 2.0*thick_*(wmax-wmin)*invrange;
+      gpath = srad_*(gmax-gmin)*invrange;
+      if(isnan(wpath) || isnan(gpath))throw std::runtime_error("Invalid pathlength");
+    }
+    // correct for the angle
+    wpath *= afac;
+    gpath *= afac;
     if(wpath > 0.0) mxings.push_back(MatXing(*wallmat_,wpath));
-    double gpath = gasPath(doca,ddoca,adot);
     if(gpath > 0.0) mxings.push_back(MatXing(*gasmat_,gpath));
 // for now, ignore the wire: this should be based on the probability that the wire was hit given doca and ddoca FIXME!
     if(wrad_<0.0) mxings.push_back(MatXing(*wiremat_,0.0));
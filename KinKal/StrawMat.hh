@@ -7,6 +7,8 @@
 #include "MatEnv/DetMaterial.hh"
 #include "KinKal/MatXing.hh"
 #include "MatEnv/MatDBInfo.hh"
+#include <array>
+#include <vector>
 
 namespace KinKal {
   class StrawMat {
@@ -19,6 +21,7 @@ namespace KinKal {
 	  rdmax_ = (srad_ - thick_)/srad_;
 	  wpmax_ = sqrt(8.0*srad_*thick_);
 	  ddmax_ = 0.05*srad_;
+	  fillTable();
 	}
       // construct using default materials
       StrawMat(MatEnv::MatDBInfo const& matdbinfo,double srad, double thick, double wrad) :
@@ -31,8 +34,9 @@ namespace KinKal {
       // same for wall material
       double wallPath(double doca, double ddoca, double adot) const; 
       // should add function to compute wire effect (probabilstically) FIXME!
-      // find the material crossings given doca and error on doca.  Should allow for straw and wire to have different axes FIXME!
-      void findXings(double doca, double ddoca, double adot, std::vector<MatXing>& mxings) const;
+      // find the material crossings given doca and error on doca.  The paths are the same as gasPath and wallPath, but
+      // interpolated from a table.  Should allow for straw and wire to have different axes FIXME!
+      void findXings(double doca, double ddoca, double adot, MatXingCol& mxings) const;
       double strawRadius() const { return srad_; }
       double wallThickness() const { return thick_; }
       double wireRadius() const { return wrad_; }
@@ -40,6 +44,13 @@ namespace KinKal {
       MatEnv::DetMaterial const& gasMaterial() const { return *gasmat_; }
       MatEnv::DetMaterial const& wireMaterial() const { return *wiremat_; }
     private:
+      // relative DOCA range integrated over
+      void docaRange(double doca, double ddoca, double& rdmin, double& rdmax) const;
+      // The paths averaged over a DOCA range are divided differences of the gas and wall path integrals,
+      // asin(x)+x*sqrt(1-x^2) and asin(x), x being the relative DOCA.  These are tabulated once with their
+      // derivatives, and interpolated with cubic Hermite polynomials
+      void fillTable();
+      void pathIntegrals(double rdoca, double& gint, double& wint) const;
       double srad_; // outer transverse radius of the straw
       double srad2_; // outer transverse radius of the straw squared
       double rdmax_; // maximum relative DOCA
@@ -50,6 +61,9 @@ namespace KinKal {
       const MatEnv::DetMaterial* wallmat_; // material of the straw wall
       const MatEnv::DetMaterial* gasmat_; // material of the straw gas
       const MatEnv::DetMaterial* wiremat_; // material of the wire
+      static constexpr size_t ntab_ = 256; // number of table points
+      std::vector<std::array<double,4>> ptab_; // gas integral, its derivative, wall integral, its derivative
+      double tabmin_, tabstep_; // table range
   };
 }
 #endif
@@ -25,8 +25,8 @@ namespace KinKal {
       // DXing interface
       virtual void update(PKTRAJ const& pktraj) override;
       virtual void update(PKTRAJ const& pktraj, double xtime) override;
-      // specific interface: this xing is based on TPOCA
-      void update(TPOCA const& tpoca);
+      // this xing is based on TPOCA, so can be updated from the TPOCA of a hit on the same straw
+      virtual void update(TPocaBase const& tpoca) override;
       virtual void print(std::ostream& ost=std::cout,int detail=0) const override;
       // accessors
       StrawMat const& strawMat() const { return smat_; }
@@ -35,7 +35,7 @@ namespace KinKal {
       TLine axis_; // straw axis, expressed as a timeline
   };
 
-  template <class KTRAJ> void StrawXing<KTRAJ>::update(TPOCA const& tpoca) {
+  template <class KTRAJ> void StrawXing<KTRAJ>::update(TPocaBase const& tpoca) {
     if(tpoca.usable()){
       DXING::mxings_.clear();
       smat_.findXings(tpoca.doca(),sqrt(tpoca.docaVar()),tpoca.dirDot(),DXING::mxings_);
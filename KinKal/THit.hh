@@ -10,6 +10,7 @@
 #include "KinKal/DXing.hh"
 #include "KinKal/PKTraj.hh"
 #include "KinKal/KKConfig.hh"
+#include "KinKal/TPocaBase.hh"
 #include <memory>
 #include <ostream>
 
@@ -26,7 +27,8 @@ namespace KinKal {
       // optionally create with an associated detector material crossing
       THit(DXINGPTR const& dxing,bool active=true) : dxing_(dxing), active_(active) {}
       virtual ~THit(){}
-      // compute residual and errors WRT a predicted trajectory
+      // compute residual and errors WRT a predicted trajectory.  The input residual is from the previous call,
+      // and may be used to start the calculation
       virtual void resid(PKTRAJ const& pktraj, RESIDUAL& resid) const =0;
       // count number of degrees of freedom constrained by this measurement (typically 1)
       virtual unsigned nDOF() const = 0;
@@ -35,16 +37,25 @@ namespace KinKal {
       // consistency of ancillary information not used in the residual computation
       // return value is the dimensionless number of sigma outside range, 0.0 = perfectly consistent, 1.0 is '1 sigma' tension
       virtual double tension() const = 0;
+      // alternative state of the hit (ie the opposite LR ambiguity of a drift hit), used to test changes against a fit
+      // without refitting.  altResid computes the residual the alternative state would have at the same reference as resid,
+      // returning false if there is none; useAlt switches the hit to it
+      virtual bool altResid(RESIDUAL const& resid, RESIDUAL& altresid) const { return false; }
+      virtual void useAlt() {}
       // hits may get deactivated during the fit
       bool isActive() const { return active_; }
       bool setActivity(bool newstate) { bool retval = newstate == active_; active_ = newstate; return retval; }
       // associated material information; null use_count means no material
       DXINGPTR const& detCrossing() const { return dxing_; }
       bool hasMaterial() const { return dxing_.use_count() > 0; }
+      // convergence criteria for the TPOCA calculations of this hit
+      TPocaLimits const& tpocaLimits() const { return tplimits_; }
+      void setTPocaLimits(TPocaLimits const& tplimits) { tplimits_ = tplimits; }
       virtual void print(std::ostream& ost=std::cout,int detail=0) const =0;
     private:
       DXINGPTR dxing_;
       bool active_; 
+      TPocaLimits tplimits_;
   };
 
   template <class KTRAJ> std::ostream& operator <<(std::ostream& ost, THit<KTRAJ> const& thit) {
@@ -16,6 +16,14 @@ namespace KinKal {
     TPocaHint() : particleHint_(false), sensorHint_(false), particleToca_(0.0), sensorToca_(0.0) {}
   };
 
+  // convergence criteria and iteration limits for the TPOCA calculation
+  struct TPocaLimits {
+    double precision_; // maximum change in TOCA for convergence (ns)
+    unsigned maxiter_; // maximum number of iterations on a single trajectory
+    unsigned maxpiece_; // maximum number of pieces to try on a piecewise trajectory
+    TPocaLimits(double precision=0.001, unsigned maxiter=100, unsigned maxpiece=10) : precision_(precision), maxiter_(maxiter), maxpiece_(maxpiece) {}
+  };
+
   class TPocaBase {
     public:
       enum TPStat{converged=0,unconverged,pocafailed,derivfailed,invalid,unknown};
@@ -36,6 +44,8 @@ namespace KinKal {
       Vec4 delta() const { return sensPoca_-partPoca_; } // measurement - prediction convention
       double deltaT() const { return sensPoca_.T() - partPoca_.T(); }
       bool usable() const { return status_ != pocafailed && status_ != unknown; }
+      // hint for a subsequent calculation from this result; no hint is given unless this converged
+      TPocaHint hint() const;
       TPocaBase(double precision=1e-2) : status_(invalid), doca_(-1.0), docavar_(-1.0), tocavar_(-1.0), ddot_(-1.0), precision_(precision)  {}
     protected:
       TPStat status_; // status of computation
@@ -48,6 +58,15 @@ namespace KinKal {
       static std::vector<std::string> statusNames_;
   };
 
+  inline TPocaHint TPocaBase::hint() const {
+    TPocaHint retval;
+    if(status_ == converged){
+      retval.particleHint_ = retval.sensorHint_ = true;
+      retval.particleToca_ = particleToca();
+      retval.sensorToca_ = sensorToca();
+    }
+    return retval;
+  }
 
 }
 #endif
@@ -2,12 +2,14 @@
 #include "KinKal/LHelix.hh"
 #include "KinKal/TLine.hh"
 #include "KinKal/PKTraj.hh"
+#include "KinKal/FitStats.hh"
 #include <limits>
+#include <algorithm>
 // specializations for TPoca
 using namespace std;
 namespace KinKal {
   // specialization between a looping helix and a line
-  template<> TPoca<LHelix,TLine>::TPoca(LHelix const& lhelix, TLine const& tline, TPocaHint const& hint, double precision) : TPocaBase(precision),ktraj_(&lhelix), straj_(&tline) {
+  template<> TPoca<LHelix,TLine>::TPoca(LHelix const& lhelix, TLine const& tline, TPocaHint const& hint, TPocaLimits const& limits) : TPocaBase(limits.precision_),ktraj_(&lhelix), straj_(&tline) {
     // reset status
     reset();
     double htoca,stoca;
@@ -24,12 +26,11 @@ namespace KinKal {
     // use successive linear approximation until desired precision on DOCA is met.
     double dptoca(std::numeric_limits<double>::max()), dstoca(std::numeric_limits<double>::max());
     double doca(0.0);
-    static const unsigned maxiter=100; // don't allow infinite iteration.  This should be a parameter FIXME!
     unsigned niter(0);
     // helix speed doesn't change
     double hspeed = lhelix.speed(lhelix.t0());
     // iterate until change in TOCA is less than precision
-    while((fabs(dptoca) > precision_ || fabs(dstoca) > precision_) && niter++ < maxiter) {
+    while((fabs(dptoca) > precision_ || fabs(dstoca) > precision_) && niter++ < limits.maxiter_) {
       // find helix local position and direction
       Vec3 hpos = lhelix.position(htoca);
       Vec3 hdir = lhelix.direction(htoca);
@@ -64,9 +65,11 @@ namespace KinKal {
 	break;
       }
     }
+    KKSTAT_COUNT(npoca_,1);
+    KKSTAT_COUNT(npocaiter_,std::min(niter,limits.maxiter_));
     // if successfull, finalize TPoca
     if(status_ != pocafailed){
-      if(niter < maxiter)
+      if(niter < limits.maxiter_)
         status_ = TPoca::converged;
       else
         status_ = TPoca::unconverged;
@@ -108,9 +111,8 @@ namespace KinKal {
 
   // specialization between a piecewise LHelix and a line
   typedef PKTraj<LHelix> PLHELIX;
-  template<> TPoca<PLHELIX,TLine>::TPoca(PLHELIX const& phelix, TLine const& tline, TPocaHint const& hint, double precision) : TPocaBase(precision), ktraj_(&phelix), straj_(&tline)  {
+  template<> TPoca<PLHELIX,TLine>::TPoca(PLHELIX const& phelix, TLine const& tline, TPocaHint const& hint, TPocaLimits const& limits) : TPocaBase(limits.precision_), ktraj_(&phelix), straj_(&tline)  {
     // iteratively find the nearest piece, and POCA for that piece.  Start at hints if availalble, otherwise the middle
-    static const unsigned maxiter=10; // don't allow infinite iteration.  This should be a parameter FIXME!
     unsigned niter=0;
     size_t oldindex= phelix.pieces().size();
     size_t index;
@@ -119,11 +121,11 @@ namespace KinKal {
     else
       index = size_t(rint(oldindex/2.0));
     status_ = converged; 
-    while(status_ == converged && niter++ < maxiter && index != oldindex){
+    while(status_ == converged && niter++ < limits.maxpiece_ && index != oldindex){
       // call down to LHelix TPoca
       // prepare for the next iteration
       LHelix const& piece = phelix.pieces()[index];
-      TPoca<LHelix,TLine> tpoca(piece,tline,hint,precision);
+      TPoca<LHelix,TLine> tpoca(piece,tline,hint,limits);
       status_ = tpoca.status();
       if(tpoca.usable()){
 	// copy over the rest of the state
@@ -137,9 +139,9 @@ namespace KinKal {
 	ddot_ = tpoca.dirDot();
       }
       oldindex = index;
-      index = phelix.nearestIndex(tpoca.particlePoca().T());
+      index = phelix.nearestIndex(tpoca.particlePoca().T(),index);
     }
-    if(status_ == converged && niter >= maxiter) status_ = unconverged;
+    if(status_ == converged && niter >= limits.maxpiece_) status_ = unconverged;
   }
 
 }
@@ -31,8 +31,11 @@ namespace KinKal {
       // THit interface overrrides
       virtual void resid(PKTRAJ const& pktraj, RESIDUAL& resid) const override;
       void resid(TPOCA const& tpoca, RESIDUAL& resid) const; // actual implementation of resid uses TPOCA
+      TPOCA findTPoca(PKTRAJ const& pktraj, RESIDUAL const& resid) const; // find TPOCA, starting from the previous residual
       virtual void update(PKTRAJ const& pktraj, MConfig const& config, RESIDUAL& resid) override;
       virtual unsigned nDOF() const override { return 1; }
+      virtual bool altResid(RESIDUAL const& resid, RESIDUAL& altresid) const override;
+      virtual void useAlt() override { if(ambig_ != LRAmbig::null) setAmbig(flipped(ambig_)); }
       double cellSize() const { return csize_; } // approximate transverse cell size, used to set null variance
 // construct from a D2T relationship; BField is needed to compute ExB effects
       TLine const& wire() const { return wire_; }
@@ -51,17 +54,26 @@ namespace KinKal {
       double nullvar_; // variance of the error in space for null ambiguity
       LRAmbig ambig_; // current ambiguity assignment: can change during a fit
       BField const& bfield_;
+      static LRAmbig flipped(LRAmbig ambig) { return ambig == LRAmbig::left ? LRAmbig::right : LRAmbig::left; }
+      void resid(TPocaBase const& tpoca, DVEC const& dDdP, DVEC const& dTdP, LRAmbig ambig, RESIDUAL& resid) const;
   };
 
   template <class KTRAJ> void WireHit<KTRAJ>::resid(PKTRAJ const& pktraj, RESIDUAL& residual) const {
-    // compute TPOCA.  wire hit measurement time is too crude to provide a good hint
-    TPOCA tpoca(pktraj,wire_);
-    resid(tpoca,residual);
+    resid(findTPoca(pktraj,residual),residual);
+  }
+
+  template <class KTRAJ> typename WireHit<KTRAJ>::TPOCA WireHit<KTRAJ>::findTPoca(PKTRAJ const& pktraj, RESIDUAL const& residual) const {
+    // wire hit measurement time is too crude to provide a good hint, so start from the previous solution if there is one
+    TPOCA retval(pktraj,wire_,residual.tPoca().hint(),THIT::tpocaLimits());
+    // if the trajectory moved too far, the previous solution can lead to the wrong loop: start over without a hint
+    if(residual.tPoca().status() == TPOCA::converged && (retval.status() != TPOCA::converged || fabs(retval.doca()) > csize_))
+      retval = TPOCA(pktraj,wire_,TPocaHint(),THIT::tpocaLimits());
+    return retval;
   }
 
   template <class KTRAJ> void WireHit<KTRAJ>::update(PKTRAJ const& pktraj, MConfig const& mconfig, RESIDUAL& residual ) {
     // find TPOCA
-    TPOCA tpoca(pktraj,wire());
+    TPOCA tpoca = findTPoca(pktraj,residual);
     // find the wire hit updater in the update params.  If there are more than 1 throw 
     const WireHitUpdater* whupdater(0);
     for(auto const& uparams : mconfig.hitupdaters_){
@@ -88,13 +100,25 @@ namespace KinKal {
     resid(tpoca,residual);
   }
 
+  template <class KTRAJ> bool WireHit<KTRAJ>::altResid(RESIDUAL const& residual, RESIDUAL& altresid) const {
+    // only drift hits have an alternative (the other side of the wire).  Reuse the residual's TPOCA solution
+    if(ambig_ == LRAmbig::null) return false;
+    resid(residual.tPoca(),residual.dDdP(),residual.dTdP(),flipped(ambig_),altresid);
+    return true;
+  }
+
   template <class KTRAJ> void WireHit<KTRAJ>::resid(TPOCA const& tpoca, RESIDUAL& resid) const {
+    this->resid(tpoca,tpoca.dDdP(),tpoca.dTdP(),ambig_,resid);
+  }
+
+  template <class KTRAJ> void WireHit<KTRAJ>::resid(TPocaBase const& tpoca, DVEC const& dDdP, DVEC const& dTdP, LRAmbig ambig, RESIDUAL& resid) const {
     if(tpoca.usable()){
       // translate TPOCA to residual
-      if(ambig_ != LRAmbig::null){ 
-	auto iambig = static_cast<std::underlying_type<LRAmbig>::type>(ambig_);
+      if(ambig != LRAmbig::null){ 
+	auto iambig = static_cast<std::underlying_type<LRAmbig>::type>(ambig);
 	// convert DOCA to wire-local polar coordinates.  This defines azimuth WRT the B field for ExB effects
 	double rho = tpoca.doca()*iambig; // this is allowed to go negative
+	KKSTAT_COUNT(nbfield_,1);
 	Vec3 bvec = bfield_.fieldVect(tpoca.particlePoca().Vect());
 	auto pdir = bvec.Cross(wire_.dir()).Unit(); // direction perp to wire and BField
 	Vec3 dvec = tpoca.delta().Vect();
@@ -103,12 +127,12 @@ namespace KinKal {
 	double tdrift, tdvar, vdrift;
 	d2T().distanceToTime(drift, tdrift, tdvar, vdrift);
 	// residual is in time, so unit dependendence on time, distance dependence is the local drift velocity
-	DVEC dRdP = tpoca.dDdP()*iambig/vdrift - tpoca.dTdP(); 
-	resid = RESIDUAL(RESIDUAL::dtime,tpoca,tpoca.deltaT()-tdrift,tdvar,dRdP);
+	DVEC dRdP = dDdP*iambig/vdrift - dTdP; 
+	resid = RESIDUAL(RESIDUAL::dtime,tpoca,tpoca.deltaT()-tdrift,tdvar,dRdP,dDdP,dTdP);
       } else {
 	// interpret DOCA against the wire directly as the residual.  There is no direct time dependence in this case
 	// residual is in space, so unit dependendence on distance, none on time
-	resid = RESIDUAL(RESIDUAL::distance,tpoca,-tpoca.doca(),nullvar_,tpoca.dDdP());
+	resid = RESIDUAL(RESIDUAL::distance,tpoca,-tpoca.doca(),nullvar_,dDdP,dDdP,dTdP);
       }
     } else
       throw std::runtime_error("POCA failure");
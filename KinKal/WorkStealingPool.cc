@@ -0,0 +1,121 @@
+#include "KinKal/WorkStealingPool.hh"
+#include <exception>
+#include <algorithm>
+namespace KinKal {
+  namespace {
+    // identify which pool and queue the current thread works for
+    thread_local WorkStealingPool const* tpool_(0);
+    thread_local unsigned tqueue_(0);
+  }
+
+  WorkStealingPool::WorkStealingPool(unsigned nthreads) : nqueued_(0), next_(0), stop_(false) {
+    if(nthreads == 0) nthreads = std::max(std::thread::hardware_concurrency(),1u);
+    for(unsigned iq=0;iq<nthreads;iq++) queues_.emplace_back(std::make_unique<TaskQueue>());
+    // the calling thread serves queue 0
+    for(unsigned iq=1;iq<nthreads;iq++) threads_.emplace_back(&WorkStealingPool::work,this,iq);
+  }
+
+  WorkStealingPool::~WorkStealingPool() {
+    {
+      std::lock_guard<std::mutex> lock(wmutex_);
+      stop_ = true;
+    }
+    wake_.notify_all();
+    for(auto& thread : threads_) thread.join();
+  }
+
+  struct WorkStealingPool::Group {
+    std::atomic<size_t> pending_;
+    std::mutex mutex_; // protects error_, and orders the completion signal
+    std::condition_variable done_;
+    std::exception_ptr error_;
+  };
+
+  bool WorkStealingPool::take(unsigned iqueue, TASK& task, Group const* group) {
+    auto matches = [group](Entry const& entry) { return group == 0 || entry.group_ == group; };
+    {
+      auto& queue = *queues_[iqueue];
+      std::lock_guard<std::mutex> lock(queue.mutex_);
+      auto ientry = std::find_if(queue.tasks_.begin(),queue.tasks_.end(),matches);
+      if(ientry != queue.tasks_.end()){
+	task = std::move(ientry->task_);
+	queue.tasks_.erase(ientry);
+	nqueued_--;
+	return true;
+      }
+    }
+    for(unsigned iq=1;iq<queues_.size();iq++){
+      auto& victim = *queues_[(iqueue+iq)%queues_.size()];
+      std::lock_guard<std::mutex> lock(victim.mutex_);
+      auto ientry = std::find_if(victim.tasks_.rbegin(),victim.tasks_.rend(),matches);
+      if(ientry != victim.tasks_.rend()){
+	task = std::move(ientry->task_);
+	victim.tasks_.erase(std::next(ientry).base());
+	nqueued_--;
+	return true;
+      }
+    }
+    return false;
+  }
+
+  void WorkStealingPool::work(unsigned iqueue) {
+    tpool_ = this;
+    tqueue_ = iqueue;
+    TASK task;
+    while(true) {
+      if(take(iqueue,task)) {
+	task();
+	task = TASK();
+      } else {
+	std::unique_lock<std::mutex> lock(wmutex_);
+	wake_.wait(lock,[this]{ return stop_ || nqueued_ > 0; });
+	if(stop_ && nqueued_ == 0) return;
+      }
+    }
+  }
+
+  void WorkStealingPool::run(TASKCOL& tasks) {
+    if(tasks.empty())return;
+    // group bookeeping; this lives on the stack since we don't return until all the tasks are complete
+    Group group;
+    group.pending_ = tasks.size();
+    // deal the tasks round-robin, preserving their order within each queue
+    unsigned start = next_++;
+    for(size_t itask=0;itask < tasks.size(); itask++){
+      auto& queue = *queues_[(start+itask)%queues_.size()];
+      std::lock_guard<std::mutex> lock(queue.mutex_);
+      queue.tasks_.push_back(Entry{[&group,task=std::move(tasks[itask])](){
+	  try {
+	    task();
+	  } catch (...) {
+	    std::lock_guard<std::mutex> elock(group.mutex_);
+	    if(!group.error_) group.error_ = std::current_exception();
+	  }
+	  // count down under the lock, so the caller can't destroy the group before we're finished with it
+	  std::lock_guard<std::mutex> glock(group.mutex_);
+	  if(--group.pending_ == 0) group.done_.notify_all();
+	  },&group});
+      nqueued_++;
+    }
+    // synchronize with idle workers before waking them so that the wakeup can't be lost
+    { std::lock_guard<std::mutex> lock(wmutex_); }
+    wake_.notify_all();
+    tasks.clear();
+    // work on this group's tasks until it is done
+    unsigned iqueue = tpool_ == this ? tqueue_ : 0;
+    TASK task;
+    while(group.pending_ > 0){
+      if(take(iqueue,task,&group)) {
+	task();
+	task = TASK();
+      } else {
+	// none of our tasks are left to take: the rest is running on other threads, so sleep until it finishes
+	std::unique_lock<std::mutex> lock(group.mutex_);
+	group.done_.wait(lock,[&group]{ return group.pending_ == 0; });
+      }
+    }
+    // make sure the last task has released the group
+    std::lock_guard<std::mutex> lock(group.mutex_);
+    if(group.error_) std::rethrow_exception(group.error_);
+  }
+}
@@ -0,0 +1,59 @@
+#ifndef KinKal_WorkStealingPool_hh
+#define KinKal_WorkStealingPool_hh
+//
+//  Simple work-stealing thread pool used to run independent fit tasks concurrently.
+//  Each worker owns a task queue; it takes work from the front of its own queue, and when that is empty
+//  steals from the back of another worker's queue.  Tasks are dealt to the queues in the order given,
+//  so callers that order tasks by decreasing cost get largest-first scheduling, with the cheap tasks at the
+//  queue tails used to fill in the load imbalance at the end.
+//  The thread calling run() is counted as one of the workers, but it only executes tasks from its own group,
+//  then blocks until that group is complete.  run() can therefore be called from inside a task without deadlocking
+//  the pool, and a waiting caller never picks up unrelated work (which would delay it and mix up its thread-local state).
+//
+#include <functional>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <memory>
+
+namespace KinKal {
+  class WorkStealingPool {
+    public:
+      typedef std::function<void()> TASK;
+      typedef std::vector<TASK> TASKCOL;
+      // construct with the total number of threads (including the calling thread).  0 means use the hardware concurrency.
+      explicit WorkStealingPool(unsigned nthreads=0);
+      ~WorkStealingPool();
+      // disallow copy and equivalence
+      WorkStealingPool(WorkStealingPool const& ) = delete;
+      WorkStealingPool& operator =(WorkStealingPool const& ) = delete;
+      unsigned nThreads() const { return queues_.size(); }
+      // run a group of tasks, returning when they have all completed.  If any task throws, the first
+      // exception is rethrown once the whole group has finished
+      void run(TASKCOL& tasks);
+    private:
+      struct Group; // bookkeeping for the tasks of a single run() call
+      struct Entry {
+	TASK task_;
+	Group const* group_;
+      };
+      struct TaskQueue {
+	std::mutex mutex_;
+	std::deque<Entry> tasks_;
+      };
+      // take from the front of our own queue, or steal from the back of another.  If group is given, only its tasks are taken
+      bool take(unsigned iqueue, TASK& task, Group const* group=0);
+      void work(unsigned iqueue); // worker thread loop
+      std::vector<std::unique_ptr<TaskQueue>> queues_; // one queue/thread; queue 0 is shared by external callers
+      std::vector<std::thread> threads_;
+      std::atomic<unsigned> nqueued_; // number of tasks waiting in queues
+      std::atomic<unsigned> next_; // round-robin start for dealing tasks
+      std::mutex wmutex_; // mutex for waking idle workers
+      std::condition_variable wake_;
+      bool stop_;
+  };
+}
+#endif
@@ -48,38 +48,43 @@ namespace MatEnv {
 
   double cm(10.0); // temporary hack
   DetMaterial::DetMaterial(const char* detMatName, const MtrPropObj* detMtrProp):
+    DetMaterial(detMatName,MtrPropData::fromMtrProp(*detMtrProp))
+  {}
+
+  DetMaterial::DetMaterial(const char* detMatName, MtrPropData const& props):
     _msmom(15.0),
     _scatterfrac(0.9999),
     _cutOffEnergy(1000.),
     _elossType(loss),
     _name(detMatName),
-    _za(detMtrProp->getZ()/detMtrProp->getA()),
-    _zeff(detMtrProp->getZ()),
-    _aeff(detMtrProp->getA()),
-    _radthick(detMtrProp->getRadLength()/cm/cm),
-    _intLength(detMtrProp->getIntLength()/detMtrProp->getDensity()),
-    _meanion(2.*log(detMtrProp->getMeanExciEnergy()*1.0e6)),
-    _eexc(detMtrProp->getMeanExciEnergy()),
-    _x0(detMtrProp->getX0density()),
-    _x1(detMtrProp->getX1density()),
-    _delta0(detMtrProp->getDEdxFactor()),
-    _afactor(detMtrProp->getAdensity()),
-    _mpower(detMtrProp->getMdensity()),
-    _bigc(detMtrProp->getCdensity()),
-    _density(detMtrProp->getDensity()/cm/cm/cm),
-    _noem(detMtrProp->getNumberOfElements()),
-    _taul(detMtrProp->getTaul())
+    _za(props.z_/props.a_),
+    _zeff(props.z_),
+    _aeff(props.a_),
+    _radthick(props.radLength_/cm/cm),
+    _intLength(props.intLength_/props.density_),
+    _meanion(2.*log(props.meanExciEnergy_*1.0e6)),
+    _eexc(props.meanExciEnergy_),
+    _x0(props.x0density_),
+    _x1(props.x1density_),
+    _delta0(props.dEdxFactor_),
+    _afactor(props.adensity_),
+    _mpower(props.mdensity_),
+    _bigc(props.cdensity_),
+    _density(props.density_/cm/cm/cm),
+    _noem(props.nElements_),
+    _taul(props.taul_)
   {
+    size_t nelem = props.nElements_;
     _shellCorrectionVector = 
-      new std::vector< double >(detMtrProp->getShellCorrectionVector());
+      new std::vector< double >(props.shellCorrection_,props.shellCorrection_+3);
     _vecNbOfAtomsPerVolume = 
-      new std::vector< double >(detMtrProp->getVecNbOfAtomsPerVolume());
+      new std::vector< double >(props.nbOfAtomsPerVolume_,props.nbOfAtomsPerVolume_+nelem);
     _vecTau0 = 
-      new std::vector< double >(detMtrProp->getVecTau0());
-    _vecAlow = new std::vector< double >(detMtrProp->getVecAlow());
-    _vecBlow = new std::vector< double >(detMtrProp->getVecBlow());
-    _vecClow = new std::vector< double >(detMtrProp->getVecClow());
-    _vecZ = new std::vector< double >(detMtrProp->getVecZ());
+      new std::vector< double >(props.tau0_,props.tau0_+nelem);
+    _vecAlow = new std::vector< double >(props.alow_,props.alow_+nelem);
+    _vecBlow = new std::vector< double >(props.blow_,props.blow_+nelem);
+    _vecClow = new std::vector< double >(props.clow_,props.clow_+nelem);
+    _vecZ = new std::vector< double >(props.elementZ_,props.elementZ_+nelem);
     // compute cached values; these are used in detailed scattering models
     _invx0 = _density/_radthick;
     _nbar = _invx0*1.587e7*pow(_zeff,1.0/3.0)/((_zeff+1)*log(287/sqrt(_zeff)));
@@ -87,15 +92,21 @@ namespace MatEnv {
     _chia2_1 = 2.007e-5*pow(_zeff,2.0/3.0);
     _chia2_2 = 3.34*pow(_zeff*_alpha,2);
 
-    if (detMtrProp->getEnergyTcut()>0.0) {
-      _cutOffEnergy = detMtrProp->getEnergyTcut();
+    if (props.energyTcut_>0.0) {
+      _cutOffEnergy = props.energyTcut_;
       _elossType = deposit;
     }
-    if (detMtrProp->getState() == "gas" && detMtrProp->getDensity()<0.01) {
+    if (std::string(props.state_) == "gas" && props.density_<0.01) {
       _scatterfrac = 0.999999;
     }
   }
 
+  void DetMaterial::tabulate(std::vector<double> const& masses, double precision, double pmin, double pmax) {
+    // build the table from the analytic functions
+    _table.reset();
+    _table = std::make_unique<DetMaterialTable>(*this,masses,precision,pmin,pmax);
+  }
+
   DetMaterial::~DetMaterial()
   {
     delete _shellCorrectionVector;
@@ -141,6 +152,9 @@ namespace MatEnv {
 
   double
     DetMaterial::dEdx(double mom,dedxtype type,double mass) const {
+      double tdedx;
+      if(_table && type == _elossType && _table->dEdx(mom,mass,tdedx))
+	return tdedx;
       if(mom>0.0){
 	double Eexc2 = _eexc*_eexc ;
 
@@ -376,6 +390,11 @@ namespace MatEnv {
     }
 
 
+  double
+    DetMaterial::bg2Limit() {
+      return bg2lim;
+    }
+
   double
     DetMaterial::nSingleScatter(double mom,double pathlen, double mass) const {
       double beta = particleBeta(mom,mass);
@@ -17,9 +17,12 @@
 //  Babar includes
 //
 #include "MatEnv/MtrPropObj.hh"
+#include "MatEnv/MtrPropData.hh"
+#include "MatEnv/DetMaterialTable.hh"
 #include <iostream>
 #include <string>
 #include <vector>
+#include <memory>
 #include <math.h>
 #include <algorithm>
 
@@ -31,6 +34,8 @@ namespace MatEnv {
       //  Constructor
       // new style
       DetMaterial(const char* detName, const MtrPropObj* detMtrProp);
+      // construct from a flat property record, ie from the compiled material database
+      DetMaterial(const char* detName, MtrPropData const& detMtrProp);
 
       ~DetMaterial();
       //
@@ -100,6 +105,8 @@ namespace MatEnv {
       // by more than the given tolerance (fraction).  This is an _approximate_ 
       // function, based on a crude model of dE/dx.
       static double maxStepdEdx(double mom,double mass, double dEdx,double tol=0.05);
+      // (beta*gamma)^2 below which the shell correction is extrapolated
+      static double bg2Limit();
     protected:
       //
       //  Constants used in material calculations
@@ -149,6 +156,7 @@ namespace MatEnv {
       double _chic2;
       double _chia2_1;
       double _chia2_2;
+      std::unique_ptr<DetMaterialTable> _table; // optional tabulated dE/dx
 
     public:
       // baseic accessors
@@ -184,8 +192,13 @@ namespace MatEnv {
       double scatterFraction() const { return _scatterfrac;}
       void setScatterFraction(double scatterfrac) {_scatterfrac = scatterfrac;}
       double cutOffEnergy() const { return _cutOffEnergy;}
-      void setCutOffEnergy(double cutOffEnergy) {_cutOffEnergy = cutOffEnergy; _elossType = deposit; }
-      void setDEDXtype(dedxtype elossType) { _elossType = elossType;}
+      void setCutOffEnergy(double cutOffEnergy) {_cutOffEnergy = cutOffEnergy; _elossType = deposit; _table.reset(); }
+      void setDEDXtype(dedxtype elossType) { _elossType = elossType; _table.reset(); }
+      dedxtype elossType() const { return _elossType; }
+      // tabulate dE/dx for the given particle masses; energy loss calculations for those masses then interpolate
+      // the table instead of evaluating the formulas.  See DetMaterialTable
+      void tabulate(std::vector<double> const& masses, double precision=1.0e-4, double pmin=1.0, double pmax=1.0e4);
+      DetMaterialTable const* table() const { return _table.get(); }
       static constexpr double e_mass_ = 5.10998910E-01; // electron mass in MeVC^2
   };
 }
@@ -0,0 +1,88 @@
+//
+//  Tabulated energy loss for a DetMaterial
+//
+#include "MatEnv/DetMaterialTable.hh"
+#include "MatEnv/DetMaterial.hh"
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+namespace MatEnv {
+  DetMaterialTable::DetMaterialTable(DetMaterial const& dmat, std::vector<double> const& masses, double precision,
+      double pmin, double pmax) : precision_(precision), pmin_(pmin), pmax_(pmax) {
+    if(pmin <= 0.0 || pmax <= pmin || precision <= 0.0)
+      throw std::invalid_argument("DetMaterialTable: invalid tabulation range or precision");
+    for(double mass : masses){
+      Table table;
+      table.mass_ = mass;
+      table.maxerr_ = 0.0;
+      // the low-momentum shell correction is an extrapolation; don't tabulate it.  Split the range where the
+      // density correction changes form
+      double umin = std::max(log(pmin),log(mass*sqrt(DetMaterial::bg2Limit())));
+      double umax = log(pmax);
+      double ubreak = log(mass) + dmat.X0()*log(10.0);
+      std::vector<double> uedges = {umin};
+      if(ubreak > umin && ubreak < umax) uedges.push_back(ubreak);
+      uedges.push_back(umax);
+      table.umin_ = umin;
+      for(size_t iseg=0;iseg+1 < uedges.size();iseg++){
+	Segment seg;
+	seg.umin_ = uedges[iseg];
+	seg.umax_ = uedges[iseg+1];
+	if(seg.umax_ <= seg.umin_)continue;
+	// refine the grid until the interpolation is within the requested precision
+	double maxerr(0.0);
+	for(size_t nbins = minbins_; nbins <= maxbins_; nbins *= 2){
+	  maxerr = fill(dmat,mass,nbins,seg);
+	  if(maxerr < precision_)break;
+	}
+	table.maxerr_ = std::max(table.maxerr_,maxerr);
+	table.segs_.push_back(seg);
+      }
+      tables_.push_back(table);
+    }
+  }
+
+  double DetMaterialTable::fill(DetMaterial const& dmat, double mass, size_t nbins, Segment& seg) const {
+    // analytic dE/dx and its derivative WRT log(momentum).  These are evaluated strictly inside the segment, so that
+    // rounding at the edges doesn't pick up the formula on the other side of a discontinuity
+    auto dedx = [&dmat,mass,&seg](double uval) {
+      static const double umargin(1.0e-9);
+      uval = std::min(std::max(uval,seg.umin_+umargin),seg.umax_-umargin);
+      return dmat.dEdx(exp(uval),dmat.elossType(),mass); };
+    double du = (seg.umax_-seg.umin_)/nbins;
+    double ustep = std::min(1.0e-4,0.25*du);
+    auto deriv = [&dedx,&seg,ustep](double uval) {
+      uval = std::min(std::max(uval,seg.umin_+2*ustep),seg.umax_-2*ustep);
+      return (8.0*(dedx(uval+ustep)-dedx(uval-ustep)) - dedx(uval+2*ustep) + dedx(uval-2*ustep))/(12.0*ustep); };
+    seg.invdu_ = 1.0/du;
+    seg.coeffs_.resize(nbins);
+    double maxerr(0.0);
+    double y0 = dedx(seg.umin_);
+    double d0 = deriv(seg.umin_)*du;
+    for(size_t ibin=0;ibin<nbins;ibin++){
+      double uhigh = seg.umin_ + (ibin+1)*du;
+      double y1 = dedx(uhigh);
+      double d1 = deriv(uhigh)*du;
+      auto& coeff = seg.coeffs_[ibin];
+      coeff[0] = y0;
+      coeff[1] = d0;
+      coeff[2] = 3.0*(y1-y0) - 2.0*d0 - d1;
+      coeff[3] = 2.0*(y0-y1) + d0 + d1;
+      for(double tval : {0.25,0.5,0.75}){
+	double yval = dedx(uhigh-(1.0-tval)*du);
+	double yint = coeff[0] + tval*(coeff[1] + tval*(coeff[2] + tval*coeff[3]));
+	maxerr = std::max(maxerr,fabs(yint-yval)/std::max(fabs(yval),1.0e-12));
+      }
+      y0 = y1;
+      d0 = d1;
+    }
+    return maxerr;
+  }
+
+  size_t DetMaterialTable::nPoints(size_t itable) const {
+    size_t npts(0);
+    for(auto const& seg : tables_[itable].segs_) npts += seg.coeffs_.size()+1;
+    return npts;
+  }
+}
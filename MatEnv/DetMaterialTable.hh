@@ -0,0 +1,74 @@
+//
+//  Tabulated energy loss for a DetMaterial.  dE/dx is interpolated on a uniform grid in log(momentum), with a
+//  separate table for each particle mass hypothesis.  The tables are cubic Hermite splines, built once from the
+//  analytic DetMaterial functions with the grid refined until the interpolation reproduces the analytic value to
+//  the requested (relative) precision.  The grid is split where the density correction changes form, as dE/dx is
+//  not continuous there.  Momenta outside the tabulated range, including momenta below the range of the high-energy
+//  shell correction, and untabulated masses are not handled: the caller should then use the analytic calculation.
+//
+#ifndef DETMATERIALTABLE_HH
+#define DETMATERIALTABLE_HH
+#include <vector>
+#include <array>
+#include <cstddef>
+#include <cmath>
+
+namespace MatEnv {
+  class DetMaterial;
+  class DetMaterialTable {
+    public:
+      // tabulate the given material for the given masses (MeV/c^2), between pmin and pmax (MeV/c)
+      DetMaterialTable(DetMaterial const& dmat, std::vector<double> const& masses, double precision=1.0e-4,
+	  double pmin=1.0, double pmax=1.0e4);
+      // interpolated dE/dx, for the material's energy loss type.  Returns false if this momentum and mass aren't tabulated.
+      // The mass must be exactly one of the tabulated masses
+      bool dEdx(double mom, double mass, double& dedx) const {
+	for(auto const& table : tables_){
+	  if(table.mass_ == mass) {
+	    double uval = log(mom);
+	    if(uval >= table.umin_){
+	      for(auto const& seg : table.segs_){
+		if(uval < seg.umax_){
+		  double xval = (uval - seg.umin_)*seg.invdu_;
+		  size_t ibin = std::min(static_cast<size_t>(xval),seg.coeffs_.size()-1);
+		  double tval = xval - ibin;
+		  auto const& coeff = seg.coeffs_[ibin];
+		  dedx = coeff[0] + tval*(coeff[1] + tval*(coeff[2] + tval*coeff[3]));
+		  return true;
+		}
+	      }
+	    }
+	    return false;
+	  }
+	}
+	return false;
+      }
+      // accessors
+      double precision() const { return precision_; }
+      double pMin() const { return pmin_; }
+      double pMax() const { return pmax_; }
+      size_t nTables() const { return tables_.size(); }
+      double mass(size_t itable) const { return tables_[itable].mass_; }
+      size_t nPoints(size_t itable) const; // number of grid points
+      double maxError(size_t itable) const { return tables_[itable].maxerr_; } // achieved maximum relative error
+    private:
+      struct Segment {
+	double umin_, umax_; // range in log(momentum)
+	double invdu_; // inverse of the grid spacing
+	std::vector<std::array<double,4>> coeffs_; // cubic polynomial coefficients for each interval, in the fractional position
+      };
+      struct Table {
+	double mass_; // particle mass
+	double umin_; // lower edge of the 1st segment
+	double maxerr_; // maximum relative error found when building the table
+	std::vector<Segment> segs_; // continuous segments
+      };
+      // fill a segment with the given number of intervals, returning the maximum relative error inside the intervals
+      double fill(DetMaterial const& dmat, double mass, size_t nbins, Segment& seg) const;
+      double precision_;
+      double pmin_, pmax_;
+      std::vector<Table> tables_;
+      static const size_t minbins_ = 16, maxbins_ = 8192; // range for the number of intervals in a segment
+  };
+}
+#endif
@@ -0,0 +1,60 @@
+//
+//  Compiled material database
+//
+#include "MatEnv/MatCompiledDB.hh"
+#include "MatEnv/RecoMatFactory.hh"
+#include "MatEnv/MtrPropObj.hh"
+#include <algorithm>
+#include <vector>
+#include <cstring>
+#include <ios>
+
+namespace MatEnv {
+  MtrPropData const* MatCompiledDB::find(std::string const& name) {
+    auto end = materials_ + nmaterials_;
+    auto ifnd = std::lower_bound(materials_,end,name.c_str(),
+	[](MtrPropData const& mat, const char* matname) { return strcmp(mat.name_,matname) < 0; });
+    if(ifnd != end && name == ifnd->name_)
+      return ifnd;
+    else
+      return 0;
+  }
+
+  size_t MatCompiledDB::generate(std::ostream& os) {
+    auto factory = RecoMatFactory::getInstance();
+    std::vector<MtrPropData> mats;
+    for(auto const& mat : *factory->materialDictionary()){
+      MtrPropObj const* mtrprop = factory->GetMtrProperties(*mat.first);
+      if(mtrprop != 0) mats.push_back(MtrPropData::fromMtrProp(*mtrprop));
+    }
+    std::sort(mats.begin(),mats.end(),[](MtrPropData const& a, MtrPropData const& b) { return strcmp(a.name_,b.name_) < 0; });
+    // write the values as hexadecimal floating point, so that they are reproduced exactly
+    auto flags = os.flags();
+    os << std::hexfloat;
+    auto array = [&os](const double* vals, size_t nvals) {
+      os << "{";
+      for(size_t ival=0;ival<nvals;ival++) os << (ival>0 ? "," : "") << vals[ival];
+      os << "}";
+    };
+    os << "//\n// Compiled material database.  This file is generated by MatCompiledDB::generate from the text\n"
+      << "// material database (see UnitTests/MatCompiledDB_unit.cc): do not edit it\n//\n"
+      << "#include \"MatEnv/MatCompiledDB.hh\"\n\nnamespace MatEnv {\n"
+      << "  const MtrPropData MatCompiledDB::materials_[] = {\n";
+    for(auto const& mat : mats) {
+      os << "    {\"" << mat.name_ << "\",\"" << mat.state_ << "\"," << mat.z_ << "," << mat.a_ << "," << mat.density_ << ","
+	<< mat.radLength_ << "," << mat.intLength_ << "," << mat.meanExciEnergy_ << "," << mat.x0density_ << "," << mat.x1density_ << ","
+	<< mat.dEdxFactor_ << "," << mat.adensity_ << "," << mat.mdensity_ << "," << mat.cdensity_ << "," << mat.taul_ << ","
+	<< mat.energyTcut_ << ",\n      ";
+      array(mat.shellCorrection_,3);
+      os << "," << std::dec << mat.nElements_ << std::hexfloat;
+      for(auto vals : {mat.nbOfAtomsPerVolume_, mat.tau0_, mat.alow_, mat.blow_, mat.clow_, mat.elementZ_}){
+	os << ",";
+	array(vals,mat.nElements_);
+      }
+      os << "},\n";
+    }
+    os << "  };\n  const size_t MatCompiledDB::nmaterials_ = sizeof(MatCompiledDB::materials_)/sizeof(MtrPropData);\n}\n";
+    os.flags(flags);
+    return mats.size();
+  }
+}
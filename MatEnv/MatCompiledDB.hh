@@ -0,0 +1,29 @@
+//
+//  Compiled material database: the properties of every material in MaterialsList.data, derived with
+//  RecoMatFactory and stored as static data (MatCompiledDBData.cc).  Looking up a material needs no file access
+//  and no parsing.  MatCompiledDBData.cc is generated with 'generate', and must be regenerated when the text
+//  database changes; the MatCompiledDB unit test checks that it is up to date.
+//
+#ifndef MatEnv_MatCompiledDB_hh
+#define MatEnv_MatCompiledDB_hh
+#include "MatEnv/MtrPropData.hh"
+#include <string>
+#include <ostream>
+#include <cstddef>
+
+namespace MatEnv {
+  class MatCompiledDB {
+    public:
+      // find a material by name; returns 0 if it's not in the compiled database
+      static MtrPropData const* find(std::string const& name);
+      static size_t nMaterials() { return nmaterials_; }
+      static MtrPropData const& material(size_t imat) { return materials_[imat]; }
+      // write the source of MatCompiledDBData.cc, from the text database as read by RecoMatFactory.  Returns the
+      // number of materials written
+      static size_t generate(std::ostream& os);
+    private:
+      static const MtrPropData materials_[]; // sorted by name
+      static const size_t nmaterials_;
+  };
+}
+#endif
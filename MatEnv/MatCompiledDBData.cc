@@ -0,0 +1,81 @@
+//
+// Compiled material database.  This file is generated by MatCompiledDB::generate from the text
+// material database (see UnitTests/MatCompiledDB_unit.cc): do not edit it
+//
+#include "MatEnv/MatCompiledDB.hh"
+
+namespace MatEnv {
+  const MtrPropData MatCompiledDB::materials_[] = {
+    {"CF4","gas",0x1.0cccccccccccdp+3,0x1.199d60ce76f1p+4,0x1.465e892253112p-9,0x1.0feedf45614a1p+5,0x1.77f4ddcc9fa14p+6,0x1.cc363ed98fb09p-14,0x1.9d8735056f6dcp+0,0x1.00fb66daf575p+2,0x1.2c22d5b61c344p-4,0x1.c2840de616b98p-3,0x1.8p+1,0x1.4f5b7c00196cdp+3,0x1.1763e3c5b9b73p-9,0x0p+0,
+      {0x1.3f19e2e4ad056p-10,0x1.19297500def9cp-16,-0x1.375e3fc66efd3p-22},2,{0x1.e447444e6f2c3p+53,0x1.e447444e6f2c4p+55},{0x1.962606bddf01dp-13,0x1.d0ec8c7e3814fp-13},{0x1.fe07e199bc127p-52,0x1.2f9c8bbab22b4p-51},{-0x1.e3fa2a00fdd48p-46,-0x1.0d46be5682457p-45},{0x1.f5301aaf676e8p-67,0x1.5585cc1b1d425p-66},{0x1.8p+2,0x1.2p+3}},
+    {"CFiber","solid",0x1.411ff9a53c29ap+2,0x1.39ef23993b247p+3,0x1.9ae147ae147aep+0,0x1.4ba6d96b12db8p+5,0x1.4b2ab61c19deap+6,0x1.44853590925f8p-14,0x1.999999999999ap-3,0x1p+1,0x1.41a5af6e896bep-4,0x1.8b5d6cd328177p-2,0x1.8p+1,0x1.961d07bcee33cp+1,0x1.1763e3c5b9b73p-9,0x0p+0,
+      {0x1.a555ae6a1547ap-11,0x1.281e1ae6b3f96p-16,-0x1.1decdbece16d9p-22},3,{0x1.cbc3fe7879196p+65,0x1.3fd232c048eep+64,0x1.ffb6b79a0e49ap+62},{0x1.962606bddf01dp-13,0x1.bf06393c5c585p-14,0x1.bf06393c5c585p-13},{0x1.fe07e199bc127p-52,0x1.b1bf8e8a8b2aep-53,0x1.20e36d5738418p-51},{-0x1.e3fa2a00fdd48p-46,-0x1.1569f26d1bcep-46,-0x1.054c31ae53c0ep-45},{0x1.f5301aaf676e8p-67,0x1.d51fe4b8abf5cp-69,0x1.387332de51df4p-66},{0x1.8p+2,0x1p+0,0x1p+3}},
+    {"CO2","gas",0x1.d555555555555p+2,0x1.d5701807a5578p+3,0x1.e2de8709741d1p-10,0x1.2190190f5f6fep+5,0x1.642f7a6d7e11fp+6,0x1.96581f4def387p-14,0x1.9d8735056f6dcp+0,0x1.00fb66daf575p+2,0x1.3a5fee13ddf3bp-4,0x1.c36bb79a55b16p-3,0x1.8p+1,0x1.4f8d86084ffc8p+3,0x1.1763e3c5b9b73p-9,0x0p+0,
+      {0x1.0c4d9c008df4dp-10,0x1.2ad868eda4754p-16,-0x1.3336d87984272p-22},2,{0x1.663035098dfcfp+54,0x1.663035098dfcep+55},{0x1.962606bddf01dp-13,0x1.bf06393c5c585p-13},{0x1.fe07e199bc127p-52,0x1.20e36d5738418p-51},{-0x1.e3fa2a00fdd48p-46,-0x1.054c31ae53c0ep-45},{0x1.f5301aaf676e8p-67,0x1.387332de51df4p-66},{0x1.8p+2,0x1p+3}},
+    {"CsI","solid",0x1.bp+5,0x1.03cf559b3d07cp+7,0x1.21eb851eb851fp+2,0x1.0c7ae147ae148p+3,0x1.4ep+7,0x1.3006c2afa9edcp-11,0x1.13b0899205576p+0,0x1p+1,0x1.056c12ab372eep-4,0x1.cb696515bfc7p+0,0x1.8p+1,0x1.97bcc7bb5d9e1p+2,0x1.1763e3c5b9b73p-9,0x0p+0,
+      {0x1.0f6a32221a327p-6,-0x1.b14b4af34dcd4p-12,0x1.c06f9cbb3ccb4p-19},2,{0x1.236fb4bc56ec1p+63,0x1.236fb4bc56ec1p+63},{0x1.a900c7eeef267p-12,0x1.a3c9aad044c53p-12},{0x1.17761910db7c7p-50,0x1.153222cc88942p-50},{-0x1.6e9dbecafffa7p-45,-0x1.6de5672e3e49fp-45},{0x1.1f5d4cf76d95p-64,0x1.198985c874cb5p-64},{0x1.b8p+5,0x1.a8p+5}},
+    {"HeCF4","gas",0x1.ff93e2e360552p+1,0x1.07d79665a6c9ep+3,0x1.177f7886239b1p-11,0x1.59cf53870c8dfp+5,0x1.3e619d0435a17p+6,0x1.25ffdf96e0d7ap-14,0x1.d0ba6838a2a0ep+0,0x1.00fb66daf575p+2,0x1.30d8ce2fd8a8ep-4,0x1.0869ce551b2e1p-2,0x1.8p+1,0x1.6380a7885521ep+3,0x1.1763e3c5b9b73p-9,0x0p+0,
+      {0x1.cdb974381ec3dp-11,0x1.f39ccf0350965p-17,-0x1.030209162610cp-22},3,{0x1.7cb36efb25a4ep+54,0x1.1435a310f923ep+51,0x1.1435a310f924p+53},{0x1.199b903ae74d1p-13,0x1.962606bddf01dp-13,0x1.d0ec8c7e3814fp-13},{0x1.31f0ec6e51ffcp-52,0x1.fe07e199bc127p-52,0x1.2f9c8bbab22b4p-51},{-0x1.5ca5c2b334645p-46,-0x1.e3fa2a00fdd48p-46,-0x1.0d46be5682457p-45},{0x1.a0e6541a8dee4p-68,0x1.f5301aaf676e8p-67,0x1.5585cc1b1d425p-66},{0x1p+1,0x1.8p+2,0x1.2p+3}},
+    {"IT-Aluminum","solid",0x1.ap+3,0x1.afb4623d0bfa1p+4,0x1.599999999999ap+1,0x1.8028f5c28f5c3p+4,0x1.a99999999999ap+6,0x1.5184fff8df375p-13,0x1.727176cde93c8p-2,0x1p+1,0x1.2f017d8df4f46p-4,0x1.246df4131ded9p-1,0x1.8p+1,0x1.0b56ee55ceep+2,0x1.1763e3c5b9b73p-9,0x0p+0,
+      {0x1.10766bf42d457p-9,0x1.db551f6bd3faep-18,-0x1.0cf2dbd1fe99fp-22},1,{0x1.a227ebabc1f7ep+65},{0x1.06c6a42404c7fp-12},{0x1.608d241535ef4p-51},{-0x1.2617f3f34184fp-45},{0x1.c049c3c2d7919p-66},{0x1.ap+3}},
+    {"IT-CFoam","solid",0x1.8p+2,0x1.805a1cac08312p+3,0x1.eb851eb851eb8p-6,0x1.559999999999ap+5,0x1.5933333333333p+6,0x1.5099fa284d8c7p-14,0x1.5cfb4aaeb3762p+0,0x1p+1,0x1.3a2822089fd4fp-4,0x1.e1792bcfffeb2p+1,0x1.8p+1,0x1.cff1653f4c5f5p+2,0x1.1763e3c5b9b73p-9,0x0p+0,
+      {0x1.9beff8139f079p-11,0x1.3265e9c59fc0cp-16,-0x1.23d409aa1b63fp-22},1,{0x1.4dfd67e01c8b2p+60},{0x1.962606bddf01dp-13},{0x1.fe07e199bc127p-52},{-0x1.e3fa2a00fdd48p-46},{0x1.f5301aaf676e8p-67},{0x1.8p+2}},
+    {"IT-Copper","solid",0x1.dp+4,0x1.fc5e353f7ced9p+5,0x1.1eb851eb851ecp+3,0x1.9b851eb851eb8p+3,0x1.0dccccccccccdp+7,0x1.5b70498a582f4p-12,0x1.d63f1d63a0dcp-2,0x1p+1,0x1.1f006035b4e53p-4,0x1.4a87b80254e0ep-1,0x1.8p+1,0x1.1e7940ec3ab78p+2,0x1.1763e3c5b9b73p-9,0x0p+0,
+      {0x1.a5f3fbc6b9eafp-8,-0x1.8ae082750c375p-14,0x1.23b5b487367fcp-21},1,{0x1.26994cff73bcap+66},{0x1.57599eb503028p-12},{0x1.d60120d483307p-51},{-0x1.56ff078d5ee34p-45},{0x1.867193bfd5957p-65},{0x1.dp+4}},
+    {"IT-Epoxy","solid",0x1.7ffffffffffffp+2,0x1.a1eb851eb851ep+3,0x1.1c28f5c28f5c3p+0,0x1.736aa43297a2bp+5,0x1.57c2def49e994p+6,0x1.5099fa284d8c7p-14,0x1.b4ef08f482c6p-3,0x1p+1,0x1.20ec56a7d7e9fp-4,0x1.ebdb3feb5ea11p-2,0x1.8p+1,0x1.dc67f00c532e9p+1,0x1.1763e3c5b9b73p-9,0x0p+0,
+      {0x1.9beff8139f07ap-11,0x1.3265e9c59fc0cp-16,-0x1.23d409aa1b64p-22},2,{0x1.f1387557faf17p+64,0x1.aa3064948df39p+63},{0x1.962606bddf01dp-13,0x1.962606bddf01dp-13},{0x1.fe07e199bc127p-52,0x1.fe07e199bc127p-52},{-0x1.e3fa2a00fdd48p-46,-0x1.e3fa2a00fdd48p-46},{0x1.f5301aaf676e8p-67,0x1.f5301aaf676e8p-67},{0x1.8p+2,0x1.8p+2}},
+    {"IT-Fwire","solid",0x1.bf89ba812a4fap+3,0x1.d538298d88861p+4,0x1.7753cddd6e04cp+1,0x1.45e957e2c64b4p+4,0x1.b7db9d69efb44p+6,0x1.79c691875a111p-13,0x1.a58c672ac9b5p-2,0x1p+1,0x1.2bea434db6dcfp-4,0x1.371086bbf404fp-1,0x1.8p+1,0x1.152329c446dep+2,0x1.1763e3c5b9b73p-9,0x0p+0,
+      {0x1.a061af30a78ap-9,-0x1.890b302977e9ap-16,0x1.bae8c3a4bee96p-28},2,{0x1.95b4837369c9fp+65,0x1.838fc72179641p+60},{0x1.06c6a42404c7fp-12,0x1.934ee954f54bfp-12},{0x1.608d241535ef4p-51,0x1.0d7c1617fe0a5p-50},{-0x1.2617f3f34184fp-45,-0x1.6ae984794313p-45},{0x1.c049c3c2d7919p-66,0x1.06f5e3eada964p-64},{0x1.ap+3,0x1.78p+5}},
+    {"IT-G10-FR4","solid",0x1.2dd97f62b6ae8p+3,0x1.2f10624dd2f1bp+4,0x1.ccccccccccccdp+0,0x1.e2b645a1cac08p+4,0x1.7eecfa35ee042p+6,0x1.f9c6211de4037p-14,0x1.2e07b6761f16cp-2,0x1p+1,0x1.392f4b4ec3b2bp-4,0x1.0dfeb32d7c6cp-1,0x1.8p+1,0x1.fc72776f4151bp+1,0x1.1763e3c5b9b73p-9,0x0p+0,
+      {0x1.66ad94a7aa0c7p-10,0x1.0a077f40e6717p-16,-0x1.399e643bd38f6p-22},1,{0x1.8d197a0d5cec8p+65},{0x1.d8429d1733c78p-13},{0x1.359deb46a1643p-51},{-0x1.10761af8bf07cp-45},{0x1.61c60282dc9bep-66},{0x1.2dd97f62b6ae8p+3}},
+    {"IT-Graphite","solid",0x1.8p+2,0x1.805a1cac08312p+3,0x1.1d70a3d70a3d7p+1,0x1.559999999999ap+5,0x1.5933333333333p+6,0x1.5099fa284d8c7p-14,0x1.999999999999ap-3,0x1p+1,0x1.3a2822089fd4dp-4,0x1.6297ae0381a41p-2,0x1.8p+1,0x1.7863e9f2dd904p+1,0x1.1763e3c5b9b73p-9,0x0p+0,
+      {0x1.9beff8139f07ap-11,0x1.3265e9c59fc0dp-16,-0x1.23d409aa1b63fp-22},1,{0x1.83ea51faf67c3p+66},{0x1.962606bddf01dp-13},{0x1.fe07e199bc127p-52},{-0x1.e3fa2a00fdd48p-46},{0x1.f5301aaf676e8p-67},{0x1.8p+2}},
+    {"IT-Hardner","solid",0x1.8p+2,0x1.a1eb851eb851fp+3,0x1.028f5c28f5c29p+0,0x1.52e147ae147aep+5,0x1.567ae147ae148p+6,0x1.5099fa284d8c7p-14,0x1.f3f756bf5d2ap-3,0x1p+1,0x1.20ec56a7d7e9fp-4,0x1.fd398606da6e2p-2,0x1.8p+1,0x1.e87d8de1f07cap+1,0x1.1763e3c5b9b73p-9,0x0p+0,
+      {0x1.9beff8139f07ap-11,0x1.3265e9c59fc0cp-16,-0x1.23d409aa1b63ep-22},1,{0x1.43294e9277efap+65},{0x1.962606bddf01dp-13},{0x1.fe07e199bc127p-52},{-0x1.e3fa2a00fdd48p-46},{0x1.f5301aaf676e8p-67},{0x1.8p+2}},
+    {"IT-InRad","solid",0x1.8p+2,0x1.805a1cac08312p+3,0x1.fecdd0d8cb07dp-4,0x1.559999999999ap+5,0x1.5933333333333p+6,0x1.5099fa284d8c7p-14,0x1.cc26968155d3ap-1,0x1p+1,0x1.3a2822089fd4ep-4,0x1.43116f8b75dfep+0,0x1.8p+1,0x1.74c1d6c3a730fp+2,0x1.1763e3c5b9b73p-9,0x0p+0,
+      {0x1.9beff8139f079p-11,0x1.3265e9c59fc0cp-16,-0x1.23d409aa1b63ep-22},1,{0x1.5b17e931cded8p+62},{0x1.962606bddf01dp-13},{0x1.fe07e199bc127p-52},{-0x1.e3fa2a00fdd48p-46},{0x1.f5301aaf676e8p-67},{0x1.8p+2}},
+    {"IT-Resin","solid",0x1.8p+2,0x1.a1eb851eb851fp+3,0x1.28f5c28f5c28fp+0,0x1.2533333333333p+5,0x1.2851eb851eb85p+6,0x1.5099fa284d8c7p-14,0x1.999999999999ap-3,0x1p+1,0x1.20ec56a7d7e9ep-4,0x1.e40d558c50bbp-2,0x1.8p+1,0x1.d6c42e10b6116p+1,0x1.1763e3c5b9b73p-9,0x0p+0,
+      {0x1.9beff8139f07ap-11,0x1.3265e9c59fc0cp-16,-0x1.23d409aa1b63fp-22},1,{0x1.7327d67075788p+65},{0x1.962606bddf01dp-13},{0x1.fe07e199bc127p-52},{-0x1.e3fa2a00fdd48p-46},{0x1.f5301aaf676e8p-67},{0x1.8p+2}},
+    {"IT-Solderer","solid",0x1.cd9f7b679c516p+5,0x1.17e3bb85d0c4cp+7,0x1.1b141205bc01ap+3,0x1.efeb2e986e5b4p+2,0x1.5870ebd495fa9p+7,0x1.4a6aed60ec963p-11,0x1.d4d0998dcf5d6p-1,0x1p+1,0x1.034eb6979f462p-4,0x1.4d34b7d2cc2aep+0,0x1.8p+1,0x1.78144db9841fep+2,0x1.1763e3c5b9b73p-9,0x0p+0,
+      {0x1.52350ed93d4e5p-6,-0x1.25ad99b88a03bp-11,0x1.39e49bb21e98ap-18},3,{0x1.8221028282c0ap+64,0x1.b6a576e9bd609p+59,0x1.00e766d324086p+63},{0x1.9bb6814cb662dp-12,0x1.934ee954f54bfp-12,0x1.e585af97129f7p-12},{0x1.11855445f746cp-50,0x1.0d7c1617fe0a5p-50,0x1.2b1338392d65dp-50},{-0x1.6c918718f2ecp-45,-0x1.6ae984794313p-45,-0x1.6f14ad3f41b8p-45},{0x1.1075fcb3cc946p-64,0x1.06f5e3eada964p-64,0x1.5f531c22c37f6p-64},{0x1.9p+5,0x1.78p+5,0x1.48p+6}},
+    {"IT-Swire","solid",0x1.6032afa42b17cp+5,0x1.95dfb69f19d2fp+6,0x1.579c23b7952d2p+3,0x1.295bce849386cp+3,0x1.38d83d761c5dfp+7,0x1.005e1a11076bbp-11,0x1.5742b24b6124cp-1,0x1p+1,0x1.10dc32e1f7531p-4,0x1.bba57fe541948p-1,0x1.8p+1,0x1.47eff4442abecp+2,0x1.1763e3c5b9b73p-9,0x0p+0,
+      {0x1.acfc87cae60dp-7,-0x1.3cf1494c478ffp-12,0x1.3d53802cca38dp-19},2,{0x1.a202223deb573p+65,0x1.832e9f6f21a2dp+61},{0x1.8477941e4781dp-12,0x1.df8709fde9126p-12},{0x1.05d9c92b2cca2p-50,0x1.29b5f7b5f424fp-50},{-0x1.674df1aa2750ap-45,-0x1.6faee76ce2c71p-45},{0x1.ec37c22ed008p-65,0x1.59676f526efc9p-64},{0x1.5p+5,0x1.3cp+6}},
+    {"IT-gas","gas",0x1.21649a1492e55p+1,0x1.05f95b0642966p+2,0x1.a1554fbdad752p-12,0x1.c3cdf509a5dacp+5,0x1.0b0ab724d9b97p+6,0x1.5e9d82a4e53cap-15,0x1.9d8735056f6dbp+0,0x1.00fb66daf575p+2,0x1.5b5afbebfd6b5p-4,0x1.9e8b097513aedp-3,0x1.8p+1,0x1.4796562d521cap+3,0x1.1763e3c5b9b73p-9,0x0p+0,
+      {0x1.ec37ee0bcd56ap-12,0x1.cc3dfa1b55e96p-17,-0x1.a12972525cc96p-23},3,{0x1.45944e0635a7cp+54,0x1.2170dc9d371b8p+53,0x1.69cd13c484e26p+54},{0x1.199b903ae74d1p-13,0x1.962606bddf01dp-13,0x1.bf06393c5c585p-14},{0x1.31f0ec6e51ffcp-52,0x1.fe07e199bc127p-52,0x1.b1bf8e8a8b2aep-53},{-0x1.5ca5c2b334645p-46,-0x1.e3fa2a00fdd48p-46,-0x1.1569f26d1bcep-46},{0x1.a0e6541a8dee4p-68,0x1.f5301aaf676e8p-67,0x1.d51fe4b8abf5cp-69},{0x1p+1,0x1.8p+2,0x1p+0}},
+    {"IT-gas1","gas",0x1.9cf89c16e0d06p+1,0x1.8b7ec7c6b291p+2,0x1.55d5f56a7ac82p-11,0x1.03ce9dcda4b5ap+5,0x1.3c9ff4b33a7a4p+6,0x1.2ac567b36ae5p-14,0x1.b720ce9f09075p+0,0x1.00fb66daf575p+2,0x1.4856d80950a4cp-4,0x1.f35af001aaaf6p-3,0x1.8p+1,0x1.5bb6efa6fee43p+3,0x1.1763e3c5b9b73p-9,0x0p+0,
+      {0x1.8da59cf90d257p-10,-0x1.7667a89bba7c7p-20,-0x1.d0b18e07afa06p-24},5,{0x1.4559aaf3e2ecfp+54,0x1.213cbbbb69ba8p+53,0x1.698beaaa4429p+54,0x1.0f3d6570c9424p+52,0x1.ce4be8f72dac2p+47},{0x1.199b903ae74d1p-13,0x1.962606bddf01dp-13,0x1.bf06393c5c585p-14,0x1.06c6a42404c7fp-12,0x1.8477941e4781dp-12},{0x1.31f0ec6e51ffcp-52,0x1.fe07e199bc127p-52,0x1.b1bf8e8a8b2aep-53,0x1.608d241535ef4p-51,0x1.05d9c92b2cca2p-50},{-0x1.5ca5c2b334645p-46,-0x1.e3fa2a00fdd48p-46,-0x1.1569f26d1bcep-46,-0x1.2617f3f34184fp-45,-0x1.674df1aa2750ap-45},{0x1.a0e6541a8dee4p-68,0x1.f5301aaf676e8p-67,0x1.d51fe4b8abf5cp-69,0x1.c049c3c2d7919p-66,0x1.ec37c22ed008p-65},{0x1p+1,0x1.8p+2,0x1p+0,0x1.ap+3,0x1.5p+5}},
+    {"Iso","gas",0x1.36db6db6db6dbp+1,0x1.09b4fc145cebbp+2,0x1.465e892253112p-9,0x1.69d566433008cp+5,0x1.1bb9295b10b96p+6,0x1.a2f3d795c7e18p-15,0x1.9d8735056f6dcp+0,0x1.00fb66daf575p+2,0x1.6fe06d5835651p-4,0x1.7650ebbcf9bc8p-4,0x1.8p+1,0x1.1678da23524dep+3,0x1.1763e3c5b9b73p-9,0x0p+0,
+      {0x1.35e3b34625c2fp-11,0x1.f69fa372270b2p-17,-0x1.d5593c1d271dfp-23},2,{0x1.6e9f7229c5f87p+56,0x1.ca474eb437768p+57},{0x1.962606bddf01dp-13,0x1.bf06393c5c585p-14},{0x1.fe07e199bc127p-52,0x1.b1bf8e8a8b2aep-53},{-0x1.e3fa2a00fdd48p-46,-0x1.1569f26d1bcep-46},{0x1.f5301aaf676e8p-67,0x1.d51fe4b8abf5cp-69},{0x1.8p+2,0x1p+0}},
+    {"Kapton","solid",0x1.6bebebebebebep+2,0x1.6872c582bef5p+3,0x1.6e147ae147ae1p+0,0x1.4734f484e10ddp+5,0x1.50fcee7ae607cp+6,0x1.56184aa5aef99p-14,0x1.999999999999ap-3,0x1p+1,0x1.3d79862323e3cp-4,0x1.b472eee926ccfp-2,0x1.8p+1,0x1.b4104b2dbb98ep+1,0x1.1763e3c5b9b73p-9,0x0p+0,
+      {0x1.b5286f1c8872ep-11,0x1.2cc94aad342bdp-16,-0x1.23f8809344e1cp-22},4,{0x1.80df1be4af6b9p+65,0x1.f34af3c0e3926p+62,0x1.4cdca28097b6fp+61,0x1.f34af3c0e3927p+62},{0x1.962606bddf01dp-13,0x1.bf06393c5c585p-13,0x1.ab9039230c1f3p-13,0x1.bf06393c5c585p-14},{0x1.fe07e199bc127p-52,0x1.20e36d5738418p-51,0x1.10cae8a2b8bcap-51,0x1.b1bf8e8a8b2aep-53},{-0x1.e3fa2a00fdd48p-46,-0x1.054c31ae53c0ep-45,-0x1.f89574eaf85cp-46,-0x1.1569f26d1bcep-46},{0x1.f5301aaf676e8p-67,0x1.387332de51df4p-66,0x1.1a326ea034ce7p-66,0x1.d51fe4b8abf5cp-69},{0x1.8p+2,0x1p+3,0x1.cp+2,0x1p+0}},
+    {"LSO","solid",0x1.88p+4,0x1.ca04395810626p+5,0x1.d99999999999ap+2,0x1.0e147ae147ae1p+3,0x1.36p+7,0x1.d5364e2f84a87p-12,0x1.7a1755bd88c88p-1,0x1p+1,0x1.0d1f3ed58e007p-4,0x1.ecae505544d1bp-1,0x1.8p+1,0x1.554ae91f0df81p+2,0x1.1763e3c5b9b73p-9,0x0p+0,
+      {0x1.347982990c092p-6,-0x1.10a9bce41a9c1p-11,0x1.2548b53c10a47p-18},3,{0x1.0e0e03b74690cp+64,0x1.0e0e03b74690dp+63,0x1.519184a51835p+65},{0x1.cec2f4f42447fp-12,0x1.0d59198dd0ce9p-12,0x1.bf06393c5c585p-13},{0x1.2532b4e958c9ep-50,0x1.6ae8dc523f25cp-51,0x1.20e36d5738418p-51},{-0x1.709c72b08e378p-45,-0x1.2b04a427b33f7p-45,-0x1.054c31ae53c0ep-45},{0x1.48465facce9d5p-64,0x1.d900202bb50fcp-66,0x1.387332de51df4p-66},{0x1.1cp+6,0x1.cp+3,0x1p+3}},
+    {"LYSO","solid",0x1.7b33333333334p+4,0x1.b8cde4a383279p+5,0x1.d99999999999ap+2,0x1.0e147ae147ae1p+3,0x1.36p+7,0x1.c327f13519e1dp-12,0x1.6c2397a41c0ecp-1,0x1p+1,0x1.0e7ff00f36572p-4,0x1.d81b7eac26e45p-1,0x1.8p+1,0x1.4ff1609f83b0dp+2,0x1.1763e3c5b9b73p-9,0x0p+0,
+      {0x1.266cb83e2cbacp-6,-0x1.01caea3801521p-11,0x1.145c290812a91p-18},4,{0x1.f91452e5099dep+63,0x1.c0f59f047a538p+60,0x1.18998362cc743p+63,0x1.5ebfe43b7f913p+65},{0x1.cec2f4f42447fp-12,0x1.7afd0da6eda09p-12,0x1.0d59198dd0ce9p-12,0x1.bf06393c5c585p-13},{0x1.2532b4e958c9ep-50,0x1.00a651f16bbeep-50,0x1.6ae8dc523f25cp-51,0x1.20e36d5738418p-51},{-0x1.709c72b08e378p-45,-0x1.648b61a106a47p-45,-0x1.2b04a427b33f7p-45,-0x1.054c31ae53c0ep-45},{0x1.48465facce9d5p-64,0x1.d6ab640091798p-65,0x1.d900202bb50fcp-66,0x1.387332de51df4p-66},{0x1.1cp+6,0x1.38p+5,0x1.cp+3,0x1p+3}},
+    {"Lexan","solid",0x1.1p+2,0x1.02ea7ef9db22dp+3,0x1.3333333333333p+0,0x1.4bae147ae147bp+5,0x1.52ccccccccccdp+6,0x1.37b2657289ebbp-14,0x1.999999999999ap-3,0x1p+1,0x1.4a55b6f438234p-4,0x1.ab965a8b67b0ap-2,0x1.8p+1,0x1.ad9a7fc9a5c8p+1,0x1.1763e3c5b9b73p-9,0x0p+0,
+      {0x1.afb33df95725p-11,0x1.1cc727aa8c23p-16,-0x1.1769fdc0acdf9p-22},3,{0x1.023a36b1020edp+65,0x1.023a36b1020edp+65,0x1.9d29f11b367e1p+63},{0x1.bf06393c5c585p-14,0x1.962606bddf01dp-13,0x1.bf06393c5c585p-13},{0x1.b1bf8e8a8b2aep-53,0x1.fe07e199bc127p-52,0x1.20e36d5738418p-51},{-0x1.1569f26d1bcep-46,-0x1.e3fa2a00fdd48p-46,-0x1.054c31ae53c0ep-45},{0x1.d51fe4b8abf5cp-69,0x1.f5301aaf676e8p-67,0x1.387332de51df4p-66},{0x1p+0,0x1.8p+2,0x1p+3}},
+    {"Mylar","solid",0x1.22e8ba2e8ba2dp+2,0x1.1785897bee18bp+3,0x1.6666666666666p+0,0x1.3f9cb74c06be5p+5,0x1.49b6d01f9c203p+6,0x1.416b405760447p-14,0x1.999999999999ap-3,0x1p+1,0x1.4741441032ce9p-4,0x1.9cf39dd25705fp-2,0x1.8p+1,0x1.a2ef20b4662cdp+1,0x1.1763e3c5b9b73p-9,0x0p+0,
+      {0x1.b708e0b8f6876p-11,0x1.201766f4964dfp-16,-0x1.1b0d5deb725d2p-22},3,{0x1.306cf2a17a9cep+65,0x1.e714b768c42e3p+63,0x1.e714b768c42e5p+64},{0x1.962606bddf01dp-13,0x1.bf06393c5c585p-13,0x1.bf06393c5c585p-14},{0x1.fe07e199bc127p-52,0x1.20e36d5738418p-51,0x1.b1bf8e8a8b2aep-53},{-0x1.e3fa2a00fdd48p-46,-0x1.054c31ae53c0ep-45,-0x1.1569f26d1bcep-46},{0x1.f5301aaf676e8p-67,0x1.387332de51df4p-66,0x1.d51fe4b8abf5cp-69},{0x1.8p+2,0x1p+3,0x1p+0}},
+    {"RPCgas","gas",0x1.2p+4,0x1.3f95810624dd3p+5,0x1.b328b6d86ec18p-10,0x1.38ccccccccccdp+4,0x1.d4ccccccccccdp+6,0x1.c45f147e76666p-13,0x1.ea5401d23c3a7p+0,0x1.00fb66daf575p+2,0x1.1b5e5fe8d3afap-4,0x1.8028a2c89dae5p-2,0x1.8p+1,0x1.896efaab2aea7p+3,0x1.1763e3c5b9b73p-9,0x0p+0,
+      {0x1.a91274d88d173p-9,-0x1.e4007b38016e5p-17,-0x1.b3029e8f26274p-24},1,{0x1.639e4f6ce61fbp+54},{0x1.24e23f55bfc9dp-12},{0x1.8f0aa8fb073bep-51},{-0x1.3b4d463a439f5p-45},{0x1.1ac509693b79ep-65},{0x1.2p+4}},
+    {"Target","solid",0x1.ap+3,0x1.afb4623d0bfa1p+4,0x1.599999999999ap+1,0x1.8028f5c28f5c3p+4,0x1.a99999999999ap+6,0x1.5184fff8df375p-13,0x1.727176cde93c8p-2,0x1p+1,0x1.2f017d8df4f46p-4,0x1.246df4131ded9p-1,0x1.8p+1,0x1.0b56ee55ceep+2,0x1.1763e3c5b9b73p-9,0x0p+0,
+      {0x1.10766bf42d457p-9,0x1.db551f6bd3faep-18,-0x1.0cf2dbd1fe99fp-22},1,{0x1.a227ebabc1f7ep+65},{0x1.06c6a42404c7fp-12},{0x1.608d241535ef4p-51},{-0x1.2617f3f34184fp-45},{0x1.c049c3c2d7919p-66},{0x1.ap+3}},
+    {"air","gas",0x1.cf3c12e415df4p+2,0x1.cf64f97f8411p+3,0x1.522a6f3f52fc2p-10,0x1.2547ae147ae14p+5,0x1.68p+6,0x1.8f1dea1123ddcp-14,0x1.b333333333333p+0,0x1p+2,0x1.3a5619e01859cp-4,0x1.e952041c36cc6p-3,0x1.8p+1,0x1.578bafa432712p+3,0x1.1763e3c5b9b73p-9,0x0p+0,
+      {0x1.033f5c041cb97p-10,0x1.2f64a1e65c8fp-16,-0x1.337d118c6aa6bp-22},2,{0x1.227179deeaa83p+55,0x1.6af25f6f36768p+53},{0x1.ab9039230c1f3p-13,0x1.bf06393c5c585p-13},{0x1.10cae8a2b8bcap-51,0x1.20e36d5738418p-51},{-0x1.f89574eaf85cp-46,-0x1.054c31ae53c0ep-45},{0x1.1a326ea034ce7p-66,0x1.387332de51df4p-66},{0x1.cp+2,0x1p+3}},
+    {"cathode","solid",0x1.027914ecda648p+4,0x1.1619fd88266a9p+5,0x1.4cccccccccccdp+2,0x1.c33630e8a4b66p+3,0x1.f536ee94964c8p+6,0x1.18129ef6ad337p-12,0x1.f5ede0f468e2cp-2,0x1p+1,0x1.2440465dcc242p-4,0x1.58312d227412dp-1,0x1.8p+1,0x1.248c3b39d9ff8p+2,0x1.1763e3c5b9b73p-9,0x0p+0,
+      {0x1.728968c5347d7p-8,-0x1.4c45c1d30d6e8p-14,0x1.d62e8e955cc82p-22},6,{0x1.2770c75dce088p+65,0x1.2a2d23e5c1068p+64,0x1.dd15063c680a8p+62,0x1.dd15063c680a9p+63,0x1.148b23ec327b7p+55,0x1.5e7b9a305b756p+57},{0x1.57599eb503028p-12,0x1.962606bddf01dp-13,0x1.bf06393c5c585p-13,0x1.bf06393c5c585p-14,0x1.df8709fde9126p-12,0x1.06c6a42404c7fp-12},{0x1.d60120d483307p-51,0x1.fe07e199bc127p-52,0x1.20e36d5738418p-51,0x1.b1bf8e8a8b2aep-53,0x1.29b5f7b5f424fp-50,0x1.608d241535ef4p-51},{-0x1.56ff078d5ee34p-45,-0x1.e3fa2a00fdd48p-46,-0x1.054c31ae53c0ep-45,-0x1.1569f26d1bcep-46,-0x1.6faee76ce2c71p-45,-0x1.2617f3f34184fp-45},{0x1.867193bfd5957p-65,0x1.f5301aaf676e8p-67,0x1.387332de51df4p-66,0x1.d51fe4b8abf5cp-69,0x1.59676f526efc9p-64,0x1.c049c3c2d7919p-66},{0x1.dp+4,0x1.8p+2,0x1p+3,0x1p+0,0x1.3cp+6,0x1.ap+3}},
+    {"straw-gas","gas",0x1.ad369f65801fbp+3,0x1.d13d38a5e2bb9p+4,0x1.bd1ed9dfdac69p-10,0x1.5b73caa5f904p+4,0x1.bb4a66998dp+6,0x1.76c43c3deeb27p-13,0x1.ea5401d23c3a7p+0,0x1.00fb66daf575p+2,0x1.221881b411cbfp-4,0x1.51715bff9761ap-2,0x1.8p+1,0x1.7be9e3ca7a553p+3,0x1.1763e3c5b9b73p-9,0x1.47ae147ae147bp-7,
+      {0x1.64abe30546e1fp-9,-0x1.cb5a55b0cc0bap-18,-0x1.36d436d3baeebp-23},3,{0x1.1cd6805344badp+54,0x1.1e8c955b5a997p+52,0x1.1e8c955b5a997p+53},{0x1.24e23f55bfc9dp-12,0x1.962606bddf01dp-13,0x1.bf06393c5c585p-13},{0x1.8f0aa8fb073bep-51,0x1.fe07e199bc127p-52,0x1.20e36d5738418p-51},{-0x1.3b4d463a439f5p-45,-0x1.e3fa2a00fdd48p-46,-0x1.054c31ae53c0ep-45},{0x1.1ac509693b79ep-65,0x1.f5301aaf676e8p-67,0x1.387332de51df4p-66},{0x1.2p+4,0x1.8p+2,0x1p+3}},
+    {"straw-wall","solid",0x1.290f740b7b1ep+2,0x1.1ee1ae4d6c434p+3,0x1.6eb851eb851ecp+0,0x1.2222b2f001c14p+5,0x1.4e08a1e104201p+6,0x1.4f148dc2f3bafp-14,0x1.999999999999ap-3,0x1p+1,0x1.4599fc89ab1cep-4,0x1.a86dc2c7000cp-2,0x1.8p+1,0x1.ab4d08f517aa7p+1,0x1.1763e3c5b9b73p-9,0x1.8p+0,
+      {0x1.4a767c7b54231p-10,0x1.24cdb568bc3e9p-18,-0x1.47da77e4efeecp-23},5,{0x1.2dfdf8a57d93bp+65,0x1.e32ff43bfc1fap+63,0x1.e32ff43bfc1fap+64,0x1.18151a156d8dap+56,0x1.62f7ca55803fbp+58},{0x1.962606bddf01dp-13,0x1.bf06393c5c585p-13,0x1.bf06393c5c585p-14,0x1.df8709fde9126p-12,0x1.06c6a42404c7fp-12},{0x1.fe07e199bc127p-52,0x1.20e36d5738418p-51,0x1.b1bf8e8a8b2aep-53,0x1.29b5f7b5f424fp-50,0x1.608d241535ef4p-51},{-0x1.e3fa2a00fdd48p-46,-0x1.054c31ae53c0ep-45,-0x1.1569f26d1bcep-46,-0x1.6faee76ce2c71p-45,-0x1.2617f3f34184fp-45},{0x1.f5301aaf676e8p-67,0x1.387332de51df4p-66,0x1.d51fe4b8abf5cp-69,0x1.59676f526efc9p-64,0x1.c049c3c2d7919p-66},{0x1.8p+2,0x1p+3,0x1p+0,0x1.3cp+6,0x1.ap+3}},
+    {"straw-wire","solid",0x1.28p+6,0x1.6fae147ae147bp+7,0x1.34ccccccccccdp+4,0x1.b0d5221d14e1ep+2,0x1.72438e349c772p+7,0x1.93a4d9f10f486p-11,0x1.99717635e02fcp-1,0x1p+1,0x1.fa4940ce975ebp-5,0x1.100f3406f3e4bp+0,0x1.8p+1,0x1.615069cad7881p+2,0x1.1763e3c5b9b73p-9,0x0p+0,
+      {0x1.bd396412e6299p-6,-0x1.9b9faf84bab54p-11,0x1.c19ba28fc922bp-18},1,{0x1.b6b0d7ec699e2p+65},{0x1.d5308a9bb4e4fp-12},{0x1.270c4e2948ab2p-50},{-0x1.70631ffac9583p-45},{0x1.4eef5887cfba5p-64},{0x1.28p+6}},
+    {"straw_15um","solid",0x1.39151372d02c3p+2,0x1.31401e96944f4p+3,0x1.3bb83cf2cf95dp-6,0x1.122743af059c9p+5,0x1.555a6f1c80279p+6,0x1.64dec28fbc207p-14,0x1.897e051f05112p+0,0x1p+1,0x1.428333a4a73f2p-4,0x1.c62567d8599a1p+2,0x1.8p+1,0x1.f213af1e12054p+2,0x1.1763e3c5b9b73p-9,0x0p+0,
+      {0x1.686cdcf984c37p-10,0x1.d3e2f68468665p-19,-0x1.4685696147ffdp-23},6,{0x1.df2b3af188d6ap+58,0x1.8d7b265e89277p+57,0x1.7bcc7159e68cfp+58,0x1.b84e19b2a299dp+49,0x1.1703bde82b62dp+52,0x1.193ac7f1d1f5p+54},{0x1.962606bddf01dp-13,0x1.bf06393c5c585p-13,0x1.bf06393c5c585p-14,0x1.df8709fde9126p-12,0x1.06c6a42404c7fp-12,0x1.24e23f55bfc9dp-12},{0x1.fe07e199bc127p-52,0x1.20e36d5738418p-51,0x1.b1bf8e8a8b2aep-53,0x1.29b5f7b5f424fp-50,0x1.608d241535ef4p-51,0x1.8f0aa8fb073bep-51},{-0x1.e3fa2a00fdd48p-46,-0x1.054c31ae53c0ep-45,-0x1.1569f26d1bcep-46,-0x1.6faee76ce2c71p-45,-0x1.2617f3f34184fp-45,-0x1.3b4d463a439f5p-45},{0x1.f5301aaf676e8p-67,0x1.387332de51df4p-66,0x1.d51fe4b8abf5cp-69,0x1.59676f526efc9p-64,0x1.c049c3c2d7919p-66,0x1.1ac509693b79ep-65},{0x1.8p+2,0x1p+3,0x1p+0,0x1.3cp+6,0x1.ap+3,0x1.2p+4}},
+    {"straw_25um","solid",0x1.32c4ec5b2340bp+2,0x1.2a033a8b73a7fp+3,0x1.f6a93f290abb4p-6,0x1.1800fe773aa8bp+5,0x1.528a182f5fe74p+6,0x1.5c64ca8379ea8p-14,0x1.5e5d7605274e6p+0,0x1p+1,0x1.43af2791970edp-4,0x1.e9b7774760acep+1,0x1.8p+1,0x1.d100ff6a09b9cp+2,0x1.1763e3c5b9b73p-9,0x0p+0,
+      {0x1.5cfe2d0e4cc99p-10,0x1.0066df0fa975cp-18,-0x1.47078b54ce17fp-23},6,{0x1.89c53bd425d94p+59,0x1.4201847033e52p+58,0x1.3944dab818dffp+59,0x1.6b2d2cf28bed8p+50,0x1.cc475e336306dp+52,0x1.15e9c86e7b08fp+54},{0x1.962606bddf01dp-13,0x1.bf06393c5c585p-13,0x1.bf06393c5c585p-14,0x1.df8709fde9126p-12,0x1.06c6a42404c7fp-12,0x1.24e23f55bfc9dp-12},{0x1.fe07e199bc127p-52,0x1.20e36d5738418p-51,0x1.b1bf8e8a8b2aep-53,0x1.29b5f7b5f424fp-50,0x1.608d241535ef4p-51,0x1.8f0aa8fb073bep-51},{-0x1.e3fa2a00fdd48p-46,-0x1.054c31ae53c0ep-45,-0x1.1569f26d1bcep-46,-0x1.6faee76ce2c71p-45,-0x1.2617f3f34184fp-45,-0x1.3b4d463a439f5p-45},{0x1.f5301aaf676e8p-67,0x1.387332de51df4p-66,0x1.d51fe4b8abf5cp-69,0x1.59676f526efc9p-64,0x1.c049c3c2d7919p-66,0x1.1ac509693b79ep-65},{0x1.8p+2,0x1p+3,0x1p+0,0x1.3cp+6,0x1.ap+3,0x1.2p+4}},
+    {"vacuum","gas",0x1p+0,0x1.028f5c28f5c29p+0,0x1.ef2d0f5da7dd9p-84,0x1.f960e3cc49134p+5,0x1.471df949b5aaap+5,0x1.0c6f7a0b5ed91p-16,0x1.833cb7141b276p+3,0x1.a87402dac317p+3,0x1.3754d8bac671p-3,0x1.7df22fbced7d3p+4,0x1.304189374bc6ap+2,0x1.a2aa1858e5ca8p+6,0x1.1763e3c5b9b73p-9,0x0p+0,
+      {0x1.03e5d230d7ab8p-13,0x1.dc6b2cd23f10cp-18,-0x1.8604d5986972fp-24},1,{0x1.f42c11cb0d547p-15},{0x1.bf06393c5c585p-14},{0x1.b1bf8e8a8b2aep-53},{-0x1.1569f26d1bcep-46},{0x1.d51fe4b8abf5cp-69},{0x1p+0}},
+  };
+  const size_t MatCompiledDB::nmaterials_ = sizeof(MatCompiledDB::materials_)/sizeof(MtrPropData);
+}
@@ -19,60 +19,60 @@
 
 #include <string>
 #include <map>
+#include <stdexcept>
 namespace MatEnv {
 
-  MatDBInfo::MatDBInfo() :
-    _genMatFactory(0)
+  MatDBInfo::MatDBInfo(bool compiled) :
+    _genMatFactory(0), _useCompiled(compiled), _tabPrecision(1.0e-4), _frozen(false)
   {;}
 
-  MatDBInfo::~MatDBInfo() {
-    // delete the materials
-    std::map< std::string*, DetMaterial*, PtrLess >::iterator 
-      iter = _matList.begin();
-    for (; iter != _matList.end(); ++iter) {
-      delete iter->first;
-      delete iter->second;
+  MatDBInfo::~MatDBInfo() {}
+
+  void
+    MatDBInfo::tabulate(std::vector<double> const& masses, double precision) {
+      // check under the lock, so that the database can't be frozen in between
+      std::lock_guard<std::mutex> lock(_mutex);
+      if(frozen()) throw std::logic_error("MatDBInfo: cannot tabulate a frozen material database");
+      _tabMasses = masses;
+      _tabPrecision = precision;
+      for(auto& mat : _materials) mat->tabulate(_tabMasses,_tabPrecision);
+    }
+
+  bool
+    MatDBInfo::preload( const std::vector< std::string >& matNames ) {
+      bool found(true);
+      for(auto const& matName : matNames)
+	if(materialID(matName) == noMaterial) found = false;
+      return found;
+    }
+
+  void
+    MatDBInfo::freeze() {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _frozen.store(true,std::memory_order_release);
+    }
+
+  size_t
+    MatDBInfo::nMaterials() const {
+      if(frozen()) return _materials.size();
+      std::lock_guard<std::mutex> lock(_mutex);
+      return _materials.size();
     }
-    _matList.clear();
-  }
 
   void 
     MatDBInfo::declareMaterial( const std::string& db_name,
 	const std::string& detMatName )
     {
+      std::lock_guard<std::mutex> lock(_mutex);
+      if(frozen()) throw std::logic_error("MatDBInfo: cannot declare a material in a frozen database");
       _matNameMap[detMatName] = db_name;
-      materialNames().push_back( detMatName );
+      addMaterialName( detMatName );
       return;
     }
 
   const DetMaterial*
     MatDBInfo::findDetMaterial( const std::string& matName ) const
     {
-      if (_genMatFactory == 0)
-	that()->_genMatFactory = RecoMatFactory::getInstance();
-
-      DetMaterial* theMat;
-      std::map< std::string*, DetMaterial*, PtrLess >::const_iterator pos;
-      if ((pos = _matList.find((std::string*)&matName)) != _matList.end()) {
-	theMat = pos->second;
-      } else {
-	// first, look for aliases
-	std::string theName;
-	std::map< std::string, std::string >::const_iterator matNamePos;
-	if ((matNamePos = _matNameMap.find(matName)) != _matNameMap.end()) {
-	  theName = matNamePos->second;
-	  theMat = createMaterial<DetMaterial>( theName, matName);
-	} else {
-	  //then , try to find the material name directly
-	  theMat = createMaterial<DetMaterial>( matName, matName);
-	  // if we created a new material directly, add it to the list
-	  if(theMat != 0)that()->declareMaterial(matName,matName);
-	}
-      }
-      if(theMat == 0){
-	ErrMsg( error ) << "MatDBInfo: Cannot find requested material " << matName
-	  << "." << endmsg;
-      }
-      return theMat;
+      return findDetMaterial<DetMaterial>(matName);
     }
 }
@@ -23,9 +23,16 @@
 #include "MatEnv/MaterialInfo.hh"
 #include "MatEnv/RecoMatFactory.hh"
 #include "MatEnv/MtrPropObj.hh"
+#include "MatEnv/MatCompiledDB.hh"
 #include "MatEnv/ErrLog.hh"
 #include <string>
 #include <map>
+#include <unordered_map>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <cstddef>
 
 namespace MatEnv {
 
@@ -33,83 +40,121 @@ namespace MatEnv {
   class RecoMatFactory;
   class MatBuildEnv;
 
+  //  Materials are created on first use and given an interned ID, which indexes them directly.  Until the database
+  //  is frozen, lookups are serialized by a mutex.  freeze() makes the database immutable: lookups are then lock-free,
+  //  and the materials can be shared by any number of threads.  Materials must be loaded (by lookup or preload)
+  //  before freezing; frozen lookups of other materials fail.
   class MatDBInfo : public MaterialInfo {
     public:
-      MatDBInfo();
+      static constexpr size_t noMaterial = static_cast<size_t>(-1);
+      // by default materials are taken from the compiled database (MatCompiledDB), which needs no file access or
+      // parsing; materials not found there, or all materials if compiled=false, are read from the text database
+      explicit MatDBInfo(bool compiled=true);
       virtual ~MatDBInfo();
       //  Find the material, given the name
       virtual const DetMaterial* findDetMaterial( const std::string& matName ) const;
       template <class T> const T* findDetMaterial( const std::string& matName ) const;
+      // interned ID of a material, or noMaterial if it can't be found
+      size_t materialID( const std::string& matName ) const { return findID<DetMaterial>(matName); }
+      const DetMaterial* material( size_t matID ) const {
+	if(frozen()) return _materials[matID].get();
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _materials[matID].get(); }
+      size_t nMaterials() const;
+      // load the given materials.  Returns false if any can't be found
+      bool preload( const std::vector< std::string >& matNames );
+      // make the database immutable
+      void freeze();
+      bool frozen() const { return _frozen.load(std::memory_order_acquire); }
+      // tabulate the energy loss of the materials for the given particle masses, both those already loaded and those
+      // loaded later.  See DetMaterialTable.  This must be called before freezing
+      void tabulate(std::vector<double> const& masses, double precision=1.0e-4);
       // utility functions
     private:
-      template <class T> T* createMaterial( const std::string& dbName,
+      template <class T> size_t findID( const std::string& matName ) const;
+      template <class T> size_t createMaterial( const std::string& dbName,
 	  const std::string& detMatName ) const;
       void declareMaterial( const std::string& dbName, 
 	  const std::string& detMatName );
-      // Cache of RecoMatFactory pointer
-      RecoMatFactory* _genMatFactory;
-      // Cache of list of materials for DetectorModel
-      std::map< std::string*, DetMaterial*, PtrLess > _matList;
+      // Cache of RecoMatFactory pointer; this is only created if a material is read from the text database
+      mutable RecoMatFactory* _genMatFactory;
+      bool _useCompiled;
+      // materials, indexed by ID, and the IDs of the reco material names.  These are filled on lookup until frozen
+      mutable std::vector< std::unique_ptr<DetMaterial> > _materials;
+      mutable std::unordered_map< std::string, size_t > _matIDs;
       // Map for reco- and DB material names
       std::map< std::string, std::string > _matNameMap; 
-      // function to cast-off const
-      MatDBInfo* that() const {
-	return const_cast<MatDBInfo*>(this);
-      }
+      // tabulation configuration
+      std::vector<double> _tabMasses;
+      double _tabPrecision;
+      std::atomic<bool> _frozen;
+      mutable std::mutex _mutex; // serializes lookups and loading until frozen
       // allow MatBuildEnv to mess with me
       friend class MatBuildEnv;
       friend class MatBuildCoreEnv;
   };
 
-  template <class T> T*
+  template <class T> size_t
     MatDBInfo::createMaterial( const std::string& db_name,
 	const std::string& detMatName ) const
     {
-      MtrPropObj* genMtrProp;
-      T* theMat;
-
-      if (_genMatFactory == 0)
-	that()->_genMatFactory = RecoMatFactory::getInstance();
-
-      genMtrProp = _genMatFactory->GetMtrProperties(db_name);
-      if(genMtrProp != 0){
-	theMat = new T( detMatName.c_str(), genMtrProp ) ;
-	that()->_matList[new std::string( detMatName )] = theMat;
-	return theMat;
+      std::unique_ptr<T> theMat;
+      MtrPropData const* compiledProp = _useCompiled ? MatCompiledDB::find(db_name) : 0;
+      if(compiledProp != 0){
+	theMat = std::make_unique<T>( detMatName.c_str(), *compiledProp );
       } else {
-	return 0;
+	if (_genMatFactory == 0)
+	  _genMatFactory = RecoMatFactory::getInstance();
+	MtrPropObj* genMtrProp = _genMatFactory->GetMtrProperties(db_name);
+	if(genMtrProp != 0)
+	  theMat = std::make_unique<T>( detMatName.c_str(), genMtrProp ) ;
+	else
+	  return noMaterial;
       }
+      if(!_tabMasses.empty())theMat->tabulate(_tabMasses,_tabPrecision);
+      size_t matID = _materials.size();
+      _materials.push_back(std::move(theMat));
+      _matIDs[detMatName] = matID;
+      return matID;
     }
 
-  template <class T> const T*
-    MatDBInfo::findDetMaterial( const std::string& matName ) const
+  template <class T> size_t
+    MatDBInfo::findID( const std::string& matName ) const
     {
-      if (_genMatFactory == 0)
-	that()->_genMatFactory = RecoMatFactory::getInstance();
-
-      T* theMat;
-      std::map< std::string*, DetMaterial*, PtrLess >::const_iterator pos;
-      if ((pos = _matList.find((std::string*)&matName)) != _matList.end()) {
-	theMat = (T*) pos->second;
+      size_t matID(noMaterial);
+      if(frozen()){
+	auto pos = _matIDs.find(matName);
+	if(pos != _matIDs.end()) matID = pos->second;
       } else {
-	// first, look for aliases
-	std::string theName;
-	std::map< std::string, std::string >::const_iterator matNamePos;
-	if ((matNamePos = _matNameMap.find(matName)) != _matNameMap.end()) {
-	  theName = matNamePos->second;
-	  theMat = createMaterial<T>( theName, matName);
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto pos = _matIDs.find(matName);
+	if (pos != _matIDs.end()) {
+	  matID = pos->second;
 	} else {
-	  //then , try to find the material name directly
-	  theMat = createMaterial<T>( matName, matName);
-	  // if we created a new material directly, add it to the list
-	  if(theMat != 0)that()->declareMaterial(matName,matName);
+	  // first, look for aliases
+	  std::map< std::string, std::string >::const_iterator matNamePos;
+	  if ((matNamePos = _matNameMap.find(matName)) != _matNameMap.end()) {
+	    matID = createMaterial<T>( matNamePos->second, matName);
+	  } else {
+	    //then , try to find the material name directly
+	    matID = createMaterial<T>( matName, matName);
+	    // if we created a new material directly, add it to the list
+	    if(matID != noMaterial)addMaterialName(matName);
+	  }
 	}
       }
-      if(theMat == 0){
+      if(matID == noMaterial){
 	ErrMsg( error ) << "MatDBInfo: Cannot find requested material " << matName
-	  << "." << endmsg;
+	  << (frozen() ? " in the frozen database." : ".") << endmsg;
       }
-      return theMat;
+      return matID;
+    }
+
+  template <class T> const T*
+    MatDBInfo::findDetMaterial( const std::string& matName ) const
+    {
+      size_t matID = findID<T>(matName);
+      return matID == noMaterial ? 0 : static_cast<const T*>(material(matID));
     }
 }
 #endif
@@ -34,8 +34,12 @@ namespace MatEnv {
 	return _matNameList; }
       std::vector< std::string >& materialNames() {
 	return _matNameList; }
+    protected:
+      // record a material loaded on lookup
+      void addMaterialName( const std::string& matName ) const {
+	_matNameList.push_back( matName ); }
     private:
-      std::vector< std::string > _matNameList;
+      mutable std::vector< std::string > _matNameList;
   };
 }
 #endif
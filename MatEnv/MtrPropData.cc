@@ -0,0 +1,43 @@
+//
+//  Flat copy of the material properties DetMaterial is built from
+//
+#include "MatEnv/MtrPropData.hh"
+#include "MatEnv/MtrPropObj.hh"
+#include <stdexcept>
+#include <string>
+
+namespace MatEnv {
+  MtrPropData MtrPropData::fromMtrProp(MtrPropObj const& mtrprop) {
+    MtrPropData data = {};
+    if(mtrprop.getNumberOfElements() > maxElements)
+      throw std::invalid_argument("MtrPropData: material " + mtrprop.getName() + " has too many elements");
+    data.name_ = mtrprop.getName().c_str();
+    data.state_ = mtrprop.getState().c_str();
+    data.z_ = mtrprop.getZ();
+    data.a_ = mtrprop.getA();
+    data.density_ = mtrprop.getDensity();
+    data.radLength_ = mtrprop.getRadLength();
+    data.intLength_ = mtrprop.getIntLength();
+    data.meanExciEnergy_ = mtrprop.getMeanExciEnergy();
+    data.x0density_ = mtrprop.getX0density();
+    data.x1density_ = mtrprop.getX1density();
+    data.dEdxFactor_ = mtrprop.getDEdxFactor();
+    data.adensity_ = mtrprop.getAdensity();
+    data.mdensity_ = mtrprop.getMdensity();
+    data.cdensity_ = mtrprop.getCdensity();
+    data.taul_ = mtrprop.getTaul();
+    data.energyTcut_ = mtrprop.getEnergyTcut();
+    for(size_t ishell=0;ishell<3;ishell++)
+      data.shellCorrection_[ishell] = mtrprop.getShellCorrectionVector()[ishell];
+    data.nElements_ = mtrprop.getNumberOfElements();
+    for(size_t ielem=0;ielem<data.nElements_;ielem++){
+      data.nbOfAtomsPerVolume_[ielem] = mtrprop.getVecNbOfAtomsPerVolume()[ielem];
+      data.tau0_[ielem] = mtrprop.getVecTau0()[ielem];
+      data.alow_[ielem] = mtrprop.getVecAlow()[ielem];
+      data.blow_[ielem] = mtrprop.getVecBlow()[ielem];
+      data.clow_[ielem] = mtrprop.getVecClow()[ielem];
+      data.elementZ_[ielem] = mtrprop.getVecZ()[ielem];
+    }
+    return data;
+  }
+}
@@ -0,0 +1,34 @@
+//
+//  Flat copy of the material properties DetMaterial is built from.  This is filled either from a MtrPropObj (ie
+//  from the text material database), or from the compiled material database (MatCompiledDB), in which case it is
+//  static data which needs no parsing or derivation.  Units are those of MtrPropObj.
+//
+#ifndef MatEnv_MtrPropData_hh
+#define MatEnv_MtrPropData_hh
+#include <cstddef>
+
+namespace MatEnv {
+  class MtrPropObj;
+  struct MtrPropData {
+    static constexpr size_t maxElements = 8; // maximum number of elements in a material
+    const char* name_; // material name; points to storage owned by the source
+    const char* state_; // solid, liquid, or gas
+    double z_, a_; // effective atomic number and mass
+    double density_;
+    double radLength_, intLength_;
+    double meanExciEnergy_;
+    double x0density_, x1density_; // density correction parameters
+    double dEdxFactor_, adensity_, mdensity_, cdensity_;
+    double taul_;
+    double energyTcut_;
+    double shellCorrection_[3];
+    size_t nElements_;
+    // per-element quantities
+    double nbOfAtomsPerVolume_[maxElements];
+    double tau0_[maxElements], alow_[maxElements], blow_[maxElements], clow_[maxElements];
+    double elementZ_[maxElements];
+    // fill from a MtrPropObj.  This throws if the material has too many elements
+    static MtrPropData fromMtrProp(MtrPropObj const& mtrprop);
+  };
+}
+#endif
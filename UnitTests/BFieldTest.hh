@@ -9,6 +9,7 @@
 #include "KinKal/StrawHit.hh"
 #include "KinKal/StrawMat.hh"
 #include "KinKal/BField.hh"
+#include "KinKal/BFieldCache.hh"
 #include "KinKal/Vectors.hh"
 #include "CLHEP/Units/PhysicalConstants.h"
 #include "UnitTests/ToyMC.hh"
@@ -166,6 +167,17 @@ int BFieldTest(int argc, char **argv) {
   cout << "XTraj " << xptraj << " integral " << xdp << endl;
   cout << "LTraj " << lptraj << " integral " << ldp << endl;
   cout << "Nominal " << start << " integral " << ndp << endl;
+  // integrating through a sample cache gives the same result, and a 2nd pass reuses all the samples
+  BFieldCache bfcache(*BF,0.1);
+  Vec3 cdp, cdp2;
+  unsigned ceval = bfcache.integrate(xptraj, xptraj.range(),cdp);
+  unsigned neval = bfcache.nEvals();
+  bfcache.integrate(xptraj, xptraj.range(),cdp2);
+  cout << "Cached integral " << cdp << " with " << ceval << " samples, " << bfcache.nEvals()-neval << " field evaluations in 2nd pass" << endl;
+  if((cdp-xdp).R() > 1.0e-9 || (cdp2-cdp).R() > 1.0e-12 || bfcache.nEvals() != neval){
+    cout << "BFieldCache integration inconsistent" << endl;
+    return -1;
+  }
 
 // setup histograms
   TFile tpfile((KTRAJ::trajName()+"BField.root").c_str(),"RECREATE");
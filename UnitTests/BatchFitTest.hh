@@ -0,0 +1,208 @@
+//
+// ToyMC test of fitting a batch of KTRAJ-based KKTrks concurrently.  The batch results are compared to
+// the same tracks fit sequentially, and the throughput of both is reported
+//
+#include "KinKal/PKTraj.hh"
+#include "KinKal/BField.hh"
+#include "KinKal/Vectors.hh"
+#include "KinKal/KKConfig.hh"
+#include "KinKal/KKTrk.hh"
+#include "KinKal/KKTrkBatch.hh"
+#include "KinKal/WorkStealingPool.hh"
+#include "KinKal/KKTrace.hh"
+#include "UnitTests/ToyMC.hh"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <getopt.h>
+#include <vector>
+#include <cmath>
+#include <chrono>
+#include <memory>
+#include <cstdlib>
+#include <cstring>
+
+using namespace KinKal;
+using namespace std;
+void print_usage() {
+  printf("Usage: BatchFitTest --ntracks i --nthreads i --nhits i --seed i --addbf i --Bgrad f --Schedule a --trace s\n");
+}
+
+template <class KTRAJ>
+int BatchFitTest(int argc, char **argv) {
+  typedef PKTraj<KTRAJ> PKTRAJ;
+  typedef KKTrk<KTRAJ> KKTRK;
+  typedef KKTrkBatch<KTRAJ> KKTRKBATCH;
+  typedef shared_ptr<KKConfig> KKCONFIGPTR;
+  typedef typename KKTRK::THITCOL THITCOL;
+  typedef typename KKTRK::DXINGCOL DXINGCOL;
+  typedef std::chrono::high_resolution_clock Clock;
+
+  int opt;
+  unsigned ntracks(60), nthreads(0), nhits(40);
+  int iseed(124223);
+  bool addbf(false);
+  double Bgrad(0.0), zrange(3000);
+  string sfile("Schedule.txt"), tfile;
+  static struct option long_options[] = {
+    {"ntracks",     required_argument, 0, 'N'  },
+    {"nthreads",     required_argument, 0, 't'  },
+    {"nhits",     required_argument, 0, 'n'  },
+    {"seed",     required_argument, 0, 's'  },
+    {"addbf",     required_argument, 0, 'B'  },
+    {"Bgrad",     required_argument, 0, 'g'  },
+    {"Schedule",     required_argument, 0, 'u'  },
+    {"trace",     required_argument, 0, 'T'  },
+    {NULL, 0,0,0}
+  };
+  int long_index =0;
+  while ((opt = getopt_long_only(argc, argv,"",
+	  long_options, &long_index )) != -1) {
+    switch (opt) {
+      case 'N' : ntracks = atoi(optarg);
+		 break;
+      case 't' : nthreads = atoi(optarg);
+		 break;
+      case 'n' : nhits = atoi(optarg);
+		 break;
+      case 's' : iseed = atoi(optarg);
+		 break;
+      case 'B' : addbf = atoi(optarg);
+		 break;
+      case 'g' : Bgrad = atof(optarg);
+		 break;
+      case 'u' : sfile = optarg;
+		 break;
+      case 'T' : tfile = optarg;
+		 break;
+      default: print_usage();
+	       exit(EXIT_FAILURE);
+    }
+  }
+  // construct BField
+  Vec3 bnom(0.0,0.0,1.0);
+  std::unique_ptr<BField> BF;
+  if(Bgrad != 0){
+    BF = std::make_unique<GradBField>(1.0-0.5*Bgrad,1.0+0.5*Bgrad,-0.5*zrange,0.5*zrange);
+    bnom = BF->fieldVect(Vec3(0.0,0.0,0.0));
+  } else
+    BF = std::make_unique<UniformBField>(bnom);
+  // configuration, shared by all the fits
+  KKCONFIGPTR configptr = make_shared<KKConfig>(*BF);
+  configptr->addbf_ = addbf;
+  string fullfile;
+  if(strncmp(sfile.c_str(),"/",1) == 0) {
+    fullfile = string(sfile);
+  } else {
+    if(const char* source = std::getenv("PACKAGE_SOURCE")){
+      fullfile = string(source) + string("/UnitTests/") + string(sfile);
+    } else {
+      cout << "PACKAGE_SOURCE not defined" << endl;
+      return -1;
+    }
+  }
+  std::ifstream ifs (fullfile, std::ifstream::in);
+  string line;
+  while (getline(ifs,line)){
+    if(strncmp(line.c_str(),"#",1)!=0){
+      istringstream ss(line);
+      MConfig mconfig(ss);
+      configptr->schedule_.push_back(mconfig);
+    }
+  }
+  // simulate tracks with a spread of hit counts so the load is unbalanced.  The fit updates the hit and material crossing
+  // state, so simulate identical sets of tracks for each fit: sequential, batch, and batch with the effects of each track
+  // also updated on the pool, with and without concurrent forward and backward sweeps
+  const unsigned nsets(4);
+  std::vector<std::unique_ptr<KKTest::ToyMC<KTRAJ>>> toys[nsets]; // the hits reference the toy material, so keep these
+  std::vector<PKTRAJ> seeds[nsets];
+  std::vector<THITCOL> thitcols[nsets];
+  std::vector<DXINGCOL> dxingcols[nsets];
+  for(unsigned iset=0;iset<nsets;iset++){
+    for(unsigned itoy=0; itoy < 3; itoy++)
+      toys[iset].emplace_back(std::make_unique<KKTest::ToyMC<KTRAJ>>(*BF, 105.0, -1, zrange, iseed+itoy, nhits*(itoy+1)/2, true, true, -1.0, 0.511));
+    thitcols[iset].resize(ntracks);
+    dxingcols[iset].resize(ntracks);
+    for(unsigned itrk=0;itrk<ntracks;itrk++){
+      auto& toy = *toys[iset][itrk%toys[iset].size()];
+      toy.setSmearSeed(false);
+      PKTRAJ tptraj;
+      toy.simulateParticle(tptraj,thitcols[iset][itrk],dxingcols[iset][itrk]);
+      double tmid = tptraj.range().mid();
+      auto const& midhel = tptraj.nearestPiece(tmid);
+      KTRAJ seedtraj(midhel.pos4(tmid),midhel.momentum(tmid),midhel.charge(),bnom,midhel.range());
+      toy.createSeed(seedtraj);
+      seeds[iset].emplace_back(seedtraj);
+    }
+  }
+  // fit the 1st set sequentially
+  auto start = Clock::now();
+  std::vector<std::unique_ptr<KKTRK>> sfits;
+  for(unsigned itrk=0;itrk<ntracks;itrk++)
+    sfits.emplace_back(std::make_unique<KKTRK>(configptr,seeds[0][itrk],thitcols[0][itrk],dxingcols[0][itrk]));
+  double sdur = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+  // fit the same tracks as a batch
+  auto pool = std::make_shared<WorkStealingPool>(nthreads);
+  KKTRKBATCH batch(configptr,pool);
+  for(unsigned itrk=0;itrk<ntracks;itrk++)
+    batch.addTrack(seeds[1][itrk],thitcols[1][itrk],dxingcols[1][itrk]);
+  KKTrace::clear();
+  start = Clock::now();
+  auto bfits = batch.fit();
+  double bdur = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+  // save the batch fit timeline (only filled if built with KINKAL_TRACE)
+  if(!tfile.empty()){
+    size_t nspans = KKTrace::write(tfile);
+    cout << "Wrote " << nspans << " trace spans to " << tfile << endl;
+  }
+  // fit the remaining sets as batches, also updating the effects of each track on the same pool
+  std::vector<std::unique_ptr<KKTRK>> pfits[2];
+  for(unsigned isweep=0;isweep<2;isweep++){
+    KKCONFIGPTR pconfigptr = make_shared<KKConfig>(*configptr);
+    pconfigptr->pool_ = pool;
+    pconfigptr->minpareff_ = 8;
+    pconfigptr->parsweep_ = isweep == 1;
+    KKTRKBATCH pbatch(pconfigptr,pool);
+    for(unsigned itrk=0;itrk<ntracks;itrk++)
+      pbatch.addTrack(seeds[2+isweep][itrk],thitcols[2+isweep][itrk],dxingcols[2+isweep][itrk]);
+    pfits[isweep] = pbatch.fit();
+  }
+  // compare; the fits are deterministic, so the results should be identical and in the same order, iteration by iteration
+  int status(0);
+  auto compare = [&](std::vector<std::unique_ptr<KKTRK>> const& fits, const char* name) {
+    if(fits.size() != ntracks){
+      cout << name << " returned " << fits.size() << " fits for " << ntracks << " tracks" << endl;
+      status = -1;
+      return;
+    }
+    for(unsigned itrk=0;itrk<ntracks;itrk++){
+      auto const& sfit = *sfits[itrk];
+      auto const& fit = *fits[itrk];
+      double tref = sfit.fitTraj().range().mid();
+      bool same = sfit.history().size() == fit.history().size() &&
+	sfit.fitTraj().momentumMag(tref) == fit.fitTraj().momentumMag(tref);
+      for(size_t ihist=0; same && ihist < sfit.history().size(); ihist++){
+	auto const& sstat = sfit.history()[ihist];
+	auto const& stat = fit.history()[ihist];
+	same = sstat.miter_ == stat.miter_ && sstat.iter_ == stat.iter_ && sstat.status_ == stat.status_ &&
+	  sstat.chisq_ == stat.chisq_ && sstat.ndof_ == stat.ndof_;
+#ifdef KINKAL_FITSTATS
+	// the counts must not pick up work from other tracks' fits running on the same threads
+	same &= sstat.stats_.npoca_ == stat.stats_.npoca_ && sstat.stats_.npocaiter_ == stat.stats_.npocaiter_ &&
+	  sstat.stats_.nbfield_ == stat.stats_.nbfield_ && sstat.stats_.nmat_ == stat.stats_.nmat_;
+#endif
+      }
+      if(!same){
+	cout << name << " fit " << itrk << " differs from sequential fit " << endl << sfit.fitStatus() << endl << fit.fitStatus() << endl;
+	status = -2;
+      }
+    }
+  };
+  compare(bfits,"Batch");
+  compare(pfits[0],"Batch with parallel effect update");
+  compare(pfits[1],"Batch with parallel effect update and sweeps");
+  cout << ntracks << " tracks fit sequentially in " << sdur/1.0e6 << " ms, in batch with " << pool->nThreads()
+    << " threads in " << bdur/1.0e6 << " ms; speedup " << sdur/bdur << endl;
+  return status;
+}
@@ -0,0 +1,138 @@
+//
+// test DetMaterialTable: compare the tabulated energy loss with the analytic calculation, and benchmark the
+// per-call cost of both
+//
+#include "MatEnv/MatDBInfo.hh"
+#include "MatEnv/DetMaterial.hh"
+#include "MatEnv/DetMaterialTable.hh"
+
+#include <iostream>
+#include <stdio.h>
+#include <getopt.h>
+#include <chrono>
+#include <random>
+#include <cmath>
+#include <string>
+#include <vector>
+
+using namespace MatEnv;
+using namespace std;
+
+void print_usage() {
+  printf("Usage: DetMaterialTable --precision f --momstart f --momend f --nbench i\n");
+}
+
+int main(int argc, char **argv) {
+  double precision(1.0e-4);
+  double momstart(10.0), momend(1000.0);
+  unsigned nbench(200000);
+  vector<double> masses = {0.511,105.66,139.57,938.27};
+  vector<string> matnames = {"straw-gas","straw-wall","straw-wire"};
+  vector<double> thickness = {4.0,0.015,0.025}; // typical path lengths (mm)
+
+  static struct option long_options[] = {
+    {"precision",     required_argument, 0, 'p'  },
+    {"momstart",     required_argument, 0, 's'  },
+    {"momend",     required_argument, 0, 'e'  },
+    {"nbench",     required_argument, 0, 'b'  },
+    {NULL, 0,0,0}
+  };
+  int opt;
+  int long_index =0;
+  while ((opt = getopt_long_only(argc, argv,"",
+	  long_options, &long_index )) != -1) {
+    switch (opt) {
+      case 'p' : precision = atof(optarg);
+		 break;
+      case 's' : momstart = atof(optarg);
+		 break;
+      case 'e' : momend = atof(optarg);
+		 break;
+      case 'b' : nbench = atoi(optarg);
+		 break;
+      default: print_usage();
+	       exit(EXIT_FAILURE);
+    }
+  }
+  MatDBInfo matdbinfo;
+  vector<DetMaterial const*> dmats;
+  for(auto const& matname : matnames) dmats.push_back(matdbinfo.findDetMaterial(matname));
+  // random test momenta, uniform in log
+  std::mt19937 rng(12345);
+  std::uniform_real_distribution<double> ugen(log(momstart),log(momend));
+  vector<double> moms(1000);
+  for(auto& mom : moms) mom = exp(ugen(rng));
+  // analytic values, and their cost
+  typedef vector<double> VALS;
+  vector<VALS> dedx(dmats.size()), eloss(dmats.size());
+  double tanal[2] = {0.0,0.0};
+  for(size_t imat=0;imat<dmats.size();imat++){
+    for(auto mass : masses){
+      for(auto mom : moms){
+	dedx[imat].push_back(dmats[imat]->dEdx(mom,dmats[imat]->elossType(),mass));
+	eloss[imat].push_back(dmats[imat]->energyLoss(mom,thickness[imat],mass));
+      }
+    }
+  }
+  auto benchmark = [&](double* times) {
+    double sum(0.0);
+    for(size_t imat=0;imat<dmats.size();imat++){
+      auto start = std::chrono::high_resolution_clock::now();
+      for(unsigned ibench=0;ibench<nbench;ibench++)
+	sum += dmats[imat]->dEdx(moms[ibench%moms.size()],dmats[imat]->elossType(),masses[(ibench/moms.size())%masses.size()]);
+      auto mid = std::chrono::high_resolution_clock::now();
+      for(unsigned ibench=0;ibench<nbench;ibench++)
+	sum += dmats[imat]->energyLossVar(moms[ibench%moms.size()],thickness[imat],masses[(ibench/moms.size())%masses.size()]);
+      auto stop = std::chrono::high_resolution_clock::now();
+      times[0] += std::chrono::duration_cast<std::chrono::nanoseconds>(mid-start).count()/double(nbench*dmats.size());
+      times[1] += std::chrono::duration_cast<std::chrono::nanoseconds>(stop-mid).count()/double(nbench*dmats.size());
+    }
+    return sum;
+  };
+  double asum = benchmark(tanal);
+  // tabulate, and compare
+  auto start = std::chrono::high_resolution_clock::now();
+  matdbinfo.tabulate(masses,precision);
+  auto stop = std::chrono::high_resolution_clock::now();
+  cout << "Tabulated " << dmats.size() << " materials for " << masses.size() << " masses in "
+    << std::chrono::duration_cast<std::chrono::microseconds>(stop-start).count() << " us" << endl;
+  int status(0);
+  for(size_t imat=0;imat<dmats.size();imat++){
+    auto table = dmats[imat]->table();
+    if(table == 0 || table->nTables() != masses.size()){
+      cout << "Material " << dmats[imat]->name() << " not tabulated" << endl;
+      return -1;
+    }
+    double maxdedx(0.0), maxeloss(0.0);
+    size_t ival(0);
+    for(auto mass : masses){
+      for(auto mom : moms){
+	maxdedx = std::max(maxdedx,fabs(dmats[imat]->dEdx(mom,dmats[imat]->elossType(),mass)/dedx[imat][ival] - 1.0));
+	// energy loss through thick material is computed in steps, whose number can change with tiny dEdx differences
+	if(DetMaterial::maxStepdEdx(mom,mass,dedx[imat][ival]) > thickness[imat])
+	  maxeloss = std::max(maxeloss,fabs(dmats[imat]->energyLoss(mom,thickness[imat],mass)/eloss[imat][ival] - 1.0));
+	++ival;
+      }
+    }
+    cout << "Material " << dmats[imat]->name();
+    for(size_t itable=0;itable<table->nTables();itable++)
+      cout << " mass " << table->mass(itable) << " " << table->nPoints(itable) << " points";
+    cout << ", max relative difference dEdx " << maxdedx << " energy loss " << maxeloss << endl;
+    // the precision is tested at the interval centers, allow some margin
+    if(maxdedx > 2.0*precision || maxeloss > 2.0*precision){
+      cout << "Tabulated energy loss out of tolerance" << endl;
+      status = -1;
+    }
+  }
+  // untabulated masses and momenta are left to the analytic calculation
+  double tdedx;
+  if(dmats[0]->table()->dEdx(100.0,1.0,tdedx) || dmats[0]->table()->dEdx(0.1,masses[0],tdedx)){
+    cout << "DetMaterialTable covers untabulated values" << endl;
+    status = -1;
+  }
+  double ttab[2] = {0.0,0.0};
+  double tsum = benchmark(ttab);
+  cout << "dEdx analytic " << tanal[0] << " ns/call, tabulated " << ttab[0] << " ns/call" << endl;
+  cout << "energyLossVar analytic " << tanal[1] << " ns/call, tabulated " << ttab[1] << " ns/call (" << tsum/asum << ")" << endl;
+  return status;
+}
@@ -15,6 +15,7 @@
 #include "KinKal/KKHit.hh"
 #include "KinKal/DXing.hh"
 #include "KinKal/KKTrk.hh"
+#include "KinKal/KKArena.hh"
 #include "UnitTests/ToyMC.hh"
 #include "UnitTests/KKHitInfo.hh"
 #include "CLHEP/Units/PhysicalConstants.h"
@@ -32,6 +33,7 @@
 #include <memory>
 #include <cstdlib>
 #include <cstring>
+#include <algorithm>
 
 #include "TH1F.h"
 #include "TTree.h"
@@ -61,7 +63,7 @@ using namespace std;
 // avoid confusion with root
 using KinKal::TLine;
 void print_usage() {
-  printf("Usage: FitTest  --momentum f --simparticle i --fitparticle i--charge i --nhits i --hres f --seed i -maxniter i --deweight f --ambigdoca f --ntries i --simmat i--fitmat i --ttree i --Bz f --dBx f --dBy f --dBz f--Bgrad f --tollerance f--TFile c --PrintBad i --PrintDetail i --ScintHit i --addbf i --invert i --Schedule a\n");
+  printf("Usage: FitTest  --momentum f --simparticle i --fitparticle i--charge i --nhits i --hres f --seed i -maxniter i --deweight f --ambigdoca f --ntries i --simmat i--fitmat i --ttree i --Bz f --dBx f --dBy f --dBz f--Bgrad f --tollerance f--TFile c --PrintBad i --PrintDetail i --ScintHit i --addbf i --invert i --Schedule a --arena i --refit i --rescaletemp i --reftol f --chitol f --resolve i\n");
 }
 
 template <class KTRAJ>
@@ -124,6 +126,12 @@ int FitTest(int argc, char **argv) {
   int iseed(123421);
   unsigned nhits(40);
   bool simmat(true), lighthit(true);
+  bool arena(false); // allocate the fits from an arena that is reset for each try
+  bool refit(false); // test incremental refitting by removing and re-adding a hit
+  bool rescaletemp(false);
+  double reftol(0.0);
+  double chitol(0.5); // maximum change in chisq/NDOF from the default fit when testing the refit and update options
+  bool resolve(true); // test post-fit hit resolution on a copy of the track with corrupted hits
 
   static struct option long_options[] = {
     {"momentum",     required_argument, 0, 'm' },
@@ -155,6 +163,12 @@ int FitTest(int argc, char **argv) {
     {"addbf",     required_argument, 0, 'B'  },
     {"invert",     required_argument, 0, 'I'  },
     {"Schedule",     required_argument, 0, 'u'  },
+    {"arena",     required_argument, 0, 'A'  },
+    {"refit",     required_argument, 0, 'R'  },
+    {"rescaletemp",     required_argument, 0, 'E'  },
+    {"reftol",     required_argument, 0, 'O'  },
+    {"chitol",     required_argument, 0, 'C'  },
+    {"resolve",     required_argument, 0, 'V'  },
     {NULL, 0,0,0}
   };
 
@@ -214,6 +228,18 @@ int FitTest(int argc, char **argv) {
 		 break;
       case 'u' : sfile = optarg;
 		 break;
+      case 'A' : arena = atoi(optarg);
+		 break;
+      case 'R' : refit = atoi(optarg);
+		 break;
+      case 'E' : rescaletemp = atoi(optarg);
+		 break;
+      case 'O' : reftol = atof(optarg);
+		 break;
+      case 'C' : chitol = atof(optarg);
+		 break;
+      case 'V' : resolve = atoi(optarg);
+		 break;
       default: print_usage();
 	       exit(EXIT_FAILURE);
     }
@@ -266,6 +292,8 @@ int FitTest(int argc, char **argv) {
   configptr->addbf_ = addbf;
   configptr->addmat_ = fitmat;
   configptr->tol_ = tol;
+  configptr->rescaletemp_ = rescaletemp;
+  configptr->reftol_ = reftol;
   configptr->plevel_ = (KKConfig::printLevel)detail;
   // read the schedule from the file
   string fullfile;
@@ -292,6 +320,97 @@ int FitTest(int argc, char **argv) {
 // create and fit the track
   KKTRK kktrk(configptr,seedtraj,thits,dxings);
 //  kktrk.print(cout,detail);
+  if(refit && thits.size() > 0){
+    // remove a hit and add it back; each incremental refit should give a usable fit
+    auto thit = thits[thits.size()/2];
+    if(!kktrk.removeHit(thit) || !kktrk.fitStatus().usable()){
+      cout << "Refit after hit removal failed " << kktrk.fitStatus() << endl;
+      exit(1);
+    }
+    if(kktrk.addHits(THITCOL(1,thit)) != 1 || !kktrk.fitStatus().usable()){
+      cout << "Refit after hit addition failed " << kktrk.fitStatus() << endl;
+      exit(1);
+    }
+    // a hit can't be added twice
+    if(kktrk.addHits(THITCOL(1,thit)) != 0){
+      cout << "Duplicate hit added " << endl;
+      exit(1);
+    }
+    cout << "Incremental refit " << kktrk.fitStatus() << endl;
+  }
+  if(refit || rescaletemp || reftol > 0.0){
+    // these options trade exactness for speed, but shouldn't change the fit quality: compare with the default fit
+    // of a copy of the track
+    KKTest::ToyMC<KTRAJ> dtoy(*BF, mom, icharge, zrange, iseed, nhits, simmat, lighthit, ambigdoca, simmass );
+    THITCOL dthits;
+    DXINGCOL ddxings;
+    PKTRAJ dtptraj;
+    dtoy.simulateParticle(dtptraj, dthits, ddxings);
+    KKCONFIGPTR dconfigptr = make_shared<KKConfig>(*configptr);
+    dconfigptr->rescaletemp_ = false;
+    dconfigptr->reftol_ = 0.0;
+    KKTRK dfit(dconfigptr,seedtraj,dthits,ddxings);
+    auto const& fstat = kktrk.fitStatus();
+    auto const& dstat = dfit.fitStatus();
+    cout << "Default fit " << dstat << endl;
+    if(!fstat.usable() || (dstat.usable() && (fstat.ndof_ != dstat.ndof_ ||
+	    fabs(fstat.chisq_/fstat.ndof_ - dstat.chisq_/dstat.ndof_) > chitol))){
+      cout << "Fit differs from the default fit " << fstat << endl;
+      exit(1);
+    }
+  }
+  if(resolve){
+    // fit the same track with some drift hits corrupted (wrong LR ambiguities, and a time shifted far outside the resolution),
+    // and check that resolveHits restores the ambiguities, rejects the outlier, and recovers the original fit
+    KKTest::ToyMC<KTRAJ> rtoy(*BF, mom, icharge, zrange, iseed, nhits, simmat, lighthit, ambigdoca, simmass );
+    THITCOL rthits;
+    DXINGCOL rdxings;
+    PKTRAJ rtptraj;
+    rtoy.simulateParticle(rtptraj, rthits, rdxings);
+    KKTRK rfit(configptr,seedtraj,rthits,rdxings);
+    // only corrupt hits far enough from the wire that their ambiguity is well-defined
+    std::vector<STRAWHITPTR> shits;
+    for(auto const& thit : rthits) {
+      auto shptr = std::dynamic_pointer_cast<STRAWHIT>(thit);
+      if(shptr && shptr->isActive() && shptr->ambig() != LRAmbig::null && fabs(TPOCA(rfit.fitTraj(),shptr->wire()).doca()) > 1.0)
+	shits.push_back(shptr);
+    }
+    if(rfit.fitStatus().status_ == FitStatus::converged && shits.size() >= 8) {
+      std::vector<STRAWHITPTR> flips = {shits[shits.size()/4], shits[3*shits.size()/4]};
+      std::vector<LRAmbig> ambigs;
+      for(auto const& flip : flips) {
+	ambigs.push_back(flip->ambig());
+	flip->useAlt();
+      }
+      auto ohit = shits[shits.size()/2];
+      auto const& wire = ohit->wire();
+      double dt(50.0);
+      auto outlier = std::make_shared<STRAWHIT>(*BF,TLine(wire.pos0(),wire.speed()*wire.dir(),wire.t0()+dt,
+	    TRange(wire.range().low()+dt,wire.range().high()+dt)),ohit->d2T(),std::dynamic_pointer_cast<STRAWXING>(ohit->detCrossing()),ohit->ambig());
+      THITCOL bthits(rthits);
+      std::replace(bthits.begin(),bthits.end(),THITPTR(ohit),THITPTR(outlier));
+      KKTRK bfit(configptr,seedtraj,bthits,rdxings);
+      auto bstat = bfit.fitStatus();
+      // resolve 1 hit/pass, so that good hits pulled by the worst one aren't changed along with it
+      unsigned nchange(0), npass(0), nres(0);
+      do {
+	nres = bfit.resolveHits(HitResolution(5.0,1.0,1),configptr->schedule_);
+	nchange += nres;
+      } while(nres > 0 && ++npass < 10);
+      auto const& gstat = rfit.fitStatus();
+      auto const& fstat = bfit.fitStatus();
+      // the outlier's DOF are lost, and at most 1 more good hit can be rejected
+      bool resolved = fstat.usable() && !outlier->isActive() && fstat.ndof_ + outlier->nDOF() <= gstat.ndof_ &&
+	fstat.ndof_ + outlier->nDOF() + 1 >= gstat.ndof_ && fstat.chisq_/fstat.ndof_ < gstat.chisq_/gstat.ndof_ + 0.5;
+      for(size_t iflip=0;iflip < flips.size(); iflip++) resolved &= flips[iflip]->ambig() == ambigs[iflip];
+      cout << "Hit resolution changed " << nchange << " hits: corrupted fit chisq/NDOF " << bstat.chisq_ << "/" << bstat.ndof_
+	<< ", resolved " << fstat.chisq_ << "/" << fstat.ndof_ << ", original " << gstat.chisq_ << "/" << gstat.ndof_ << endl;
+      if(!resolved){
+	cout << "Hit resolution failed " << fstat << endl;
+	exit(1);
+      }
+    }
+  }
   TFile fitfile((KTRAJ::trajName() + tfname).c_str(),"RECREATE");
   // tree variables
   KTRAJPars ftpars_, btpars_, spars_, ffitpars_, ffiterrs_, bfitpars_, bfiterrs_;
@@ -437,6 +556,7 @@ int FitTest(int argc, char **argv) {
     TH1F* bmompull = new TH1F("bmompull","Back Momentum Pull;#Delta P/#sigma _{p}",100,-nsig,nsig);
     double duration (0.0);
     configptr->plevel_ = KKConfig::none;
+    KKArena kkarena;
     for(unsigned itry=0;itry<ntries;itry++){
     // create a random true initial helix with hits and material interactions from this.  This also handles BField inhomogeneity truth tracking
       PKTRAJ tptraj;
@@ -451,8 +571,9 @@ int FitTest(int argc, char **argv) {
       KTRAJ seedtraj(midhel.pos4(tmid),seedmom,midhel.charge(),bnom,midhel.range());
       if(invert)seedtraj.invertCT();
       toy.createSeed(seedtraj);
+      kkarena.reset(); // the previous fit has been destroyed
       auto start = Clock::now();
-      KKTRK kktrk(configptr,seedtraj,thits,dxings);
+      KKTRK kktrk(configptr,seedtraj,thits,dxings,arena ? &kkarena : std::pmr::get_default_resource());
       auto stop = Clock::now();
       duration += std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count();
       // compare parameters at the first traj of both true and fit
@@ -554,7 +675,7 @@ int FitTest(int argc, char **argv) {
       bmompull->Fill((bfmom_-btmom_)/bfmomerr_);
       // fill hit information
       for(auto const& eff: kktrk.effects()) {
-	const KKHIT* kkhit = dynamic_cast<const KKHIT*>(eff.get());
+	const KKHIT* kkhit = std::get_if<KKHIT>(&eff);
 	if(kkhit != 0){
 	  KKHitInfo hinfo;
 	  hinfo.active_ = kkhit->isActive();
@@ -0,0 +1,139 @@
+//
+// test GridBField: convert an ASCII dump of an analytic field, then compare the interpolated field
+// and gradient with the analytic values.  Also usable to convert an ASCII field map.
+//
+#include "KinKal/GridBField.hh"
+#include "KinKal/Vectors.hh"
+
+#include <iostream>
+#include <fstream>
+#include <stdio.h>
+#include <getopt.h>
+#include <chrono>
+#include <random>
+#include <cmath>
+#include <string>
+
+using namespace KinKal;
+using namespace std;
+
+void print_usage() {
+  printf("Usage: GridBFieldTest --convert s --output s --npts i --dBdz2 f --tol f\n");
+}
+
+int main(int argc, char **argv) {
+  string asciifile, binaryfile("GridBFieldTest.bin");
+  unsigned npts(31);
+  double dbdz2(4.0e-8); // analytic field curvature (Tesla/mm^2)
+  double tol(1.0e-6); // tolerance on the tricubic field difference (Tesla)
+  double xmax(800.0), zmax(1500.0); // grid range (mm)
+
+  static struct option long_options[] = {
+    {"convert",     required_argument, 0, 'c'  },
+    {"output",     required_argument, 0, 'o'  },
+    {"npts",     required_argument, 0, 'n'  },
+    {"dBdz2",     required_argument, 0, 'd'  },
+    {"tol",     required_argument, 0, 't'  },
+    {NULL, 0,0,0}
+  };
+  int opt;
+  int long_index =0;
+  while ((opt = getopt_long_only(argc, argv,"",
+	  long_options, &long_index )) != -1) {
+    switch (opt) {
+      case 'c' : asciifile = string(optarg);
+		 break;
+      case 'o' : binaryfile = string(optarg);
+		 break;
+      case 'n' : npts = atoi(optarg);
+		 break;
+      case 'd' : dbdz2 = atof(optarg);
+		 break;
+      case 't' : tol = atof(optarg);
+		 break;
+      default: print_usage();
+	       exit(EXIT_FAILURE);
+    }
+  }
+  // conversion only
+  if(!asciifile.empty()){
+    size_t ngrid = GridBField::convert(asciifile,binaryfile);
+    cout << "Converted " << ngrid << " grid points from " << asciifile << " to " << binaryfile << endl;
+    return 0;
+  }
+  // analytic test field: solenoid-like, with a quadratic Z dependence
+  auto bfield = [dbdz2](Vec3 const& pos) { return Vec3(-dbdz2*pos.X()*pos.Z(), -dbdz2*pos.Y()*pos.Z(), 1.0 + dbdz2*pos.Z()*pos.Z()); };
+  auto bgrad = [dbdz2](Vec3 const& pos) {
+    BField::Grad grad;
+    grad(0,0) = grad(1,1) = -dbdz2*pos.Z();
+    grad(0,2) = -dbdz2*pos.X();
+    grad(1,2) = -dbdz2*pos.Y();
+    grad(2,2) = 2.0*dbdz2*pos.Z();
+    return grad;
+  };
+  // write an ASCII dump of the field
+  asciifile = "GridBFieldTest.txt";
+  {
+    ofstream ascii(asciifile);
+    ascii << "# x y z Bx By Bz" << endl;
+    double dx = 2*xmax/(npts-1), dz = 2*zmax/(npts-1);
+    for(unsigned ix=0;ix<npts;ix++){
+      for(unsigned iy=0;iy<npts;iy++){
+	for(unsigned iz=0;iz<npts;iz++){
+	  Vec3 pos(-xmax + ix*dx, -xmax + iy*dx, -zmax + iz*dz);
+	  Vec3 bvec = bfield(pos);
+	  ascii << pos.X() << " " << pos.Y() << " " << pos.Z() << " " << bvec.X() << " " << bvec.Y() << " " << bvec.Z() << endl;
+	}
+      }
+    }
+  }
+  size_t ngrid = GridBField::convert(asciifile,binaryfile);
+  if(ngrid != npts*npts*npts){
+    cout << "Conversion failed, " << ngrid << " grid points" << endl;
+    return -1;
+  }
+  int status(0);
+  for(auto interp : {GridBField::trilinear, GridBField::tricubic}){
+    auto start = std::chrono::high_resolution_clock::now();
+    GridBField gfield(binaryfile,interp);
+    auto stop = std::chrono::high_resolution_clock::now();
+    // compare at random points inside the grid, 1 cell from the edge so that tricubic uses all its points
+    std::mt19937 rng(12345);
+    double xcell = 2*xmax/(npts-1), zcell = 2*zmax/(npts-1);
+    std::uniform_real_distribution<double> xgen(-xmax+xcell,xmax-xcell), zgen(-zmax+zcell,zmax-zcell);
+    double maxdb(0.0), maxdg(0.0), maxdd(0.0);
+    for(unsigned ipt=0;ipt<10000;ipt++){
+      Vec3 pos(xgen(rng),xgen(rng),zgen(rng));
+      maxdb = std::max(maxdb,(gfield.fieldVect(pos)-bfield(pos)).R());
+      auto dgrad = gfield.fieldGrad(pos) - bgrad(pos);
+      for(unsigned irow=0;irow<3;irow++)
+	for(unsigned icol=0;icol<3;icol++)
+	  maxdg = std::max(maxdg,fabs(dgrad(irow,icol)));
+      // the time derivative must be consistent with the gradient
+      Vec3 vel(100.0,-200.0,150.0);
+      auto grad = gfield.fieldGrad(pos);
+      Vec3 dBdt(grad(0,0)*vel.X()+grad(0,1)*vel.Y()+grad(0,2)*vel.Z(),
+	  grad(1,0)*vel.X()+grad(1,1)*vel.Y()+grad(1,2)*vel.Z(),
+	  grad(2,0)*vel.X()+grad(2,1)*vel.Y()+grad(2,2)*vel.Z());
+      maxdd = std::max(maxdd,(gfield.fieldDeriv(pos,vel)-dBdt).R());
+    }
+    // tricubic interpolation is exact for a quadratic field, up to the float precision of the map.  Trilinear
+    // interpolation misses the curvature term, which gives a maximum error of dbdz2*dz^2/4 at the cell center
+    double btol = interp == GridBField::tricubic ? tol : 1.01*dbdz2*zcell*zcell/4.0 + tol;
+    double gtol = interp == GridBField::tricubic ? tol/zcell : 1.01*dbdz2*zcell + tol/zcell;
+    cout << (interp == GridBField::trilinear ? "Trilinear" : "Tricubic") << " GridBField with " << gfield.nPoints()
+      << " points loaded in " << std::chrono::duration_cast<std::chrono::microseconds>(stop-start).count() << " us"
+      << ", max field difference " << maxdb << " max gradient difference " << maxdg << endl;
+    if(maxdb > btol || maxdg > gtol || maxdd > 1.0e-9){
+      cout << "GridBField interpolation out of tolerance" << endl;
+      status = -1;
+    }
+    // grid points are reproduced exactly
+    Vec3 gpos(-xmax+xcell,-xmax,-zmax+3*zcell);
+    if((gfield.fieldVect(gpos) - gfield.field(1,0,3)).R() > 1.0e-6){
+      cout << "GridBField doesn't reproduce grid values" << endl;
+      status = -1;
+    }
+  }
+  return status;
+}
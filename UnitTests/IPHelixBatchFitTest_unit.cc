@@ -0,0 +1,5 @@
+#include "KinKal/IPHelix.hh"
+#include "UnitTests/BatchFitTest.hh"
+int main(int argc, char **argv) {
+  return BatchFitTest<IPHelix>(argc,argv);
+}
@@ -0,0 +1,5 @@
+#include "KinKal/LHelix.hh"
+#include "UnitTests/BatchFitTest.hh"
+int main(int argc, char **argv) {
+  return BatchFitTest<LHelix>(argc,argv);
+}
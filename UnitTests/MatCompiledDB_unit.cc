@@ -0,0 +1,126 @@
+//
+// test MatCompiledDB: check that the compiled material database reproduces the text database exactly, and compare
+// the initialization time.  Also used to (re)generate the compiled database source, MatEnv/MatCompiledDBData.cc
+//
+#include "MatEnv/MatCompiledDB.hh"
+#include "MatEnv/MatDBInfo.hh"
+#include "MatEnv/DetMaterial.hh"
+#include "MatEnv/RecoMatFactory.hh"
+
+#include <iostream>
+#include <fstream>
+#include <stdio.h>
+#include <getopt.h>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <cstring>
+
+using namespace MatEnv;
+using namespace std;
+
+void print_usage() {
+  printf("Usage: MatCompiledDB --generate s\n");
+}
+
+// exact comparison of the material properties
+bool sameProps(MtrPropData const& a, MtrPropData const& b) {
+  auto same = [](const double* va, const double* vb, size_t nvals) {
+    for(size_t ival=0;ival<nvals;ival++)
+      if(va[ival] != vb[ival] && !(std::isnan(va[ival]) && std::isnan(vb[ival])))return false;
+    return true;
+  };
+  double sa[14] = {a.z_,a.a_,a.density_,a.radLength_,a.intLength_,a.meanExciEnergy_,a.x0density_,a.x1density_,
+    a.dEdxFactor_,a.adensity_,a.mdensity_,a.cdensity_,a.taul_,a.energyTcut_};
+  double sb[14] = {b.z_,b.a_,b.density_,b.radLength_,b.intLength_,b.meanExciEnergy_,b.x0density_,b.x1density_,
+    b.dEdxFactor_,b.adensity_,b.mdensity_,b.cdensity_,b.taul_,b.energyTcut_};
+  size_t nelem = a.nElements_;
+  return strcmp(a.name_,b.name_) == 0 && strcmp(a.state_,b.state_) == 0 && nelem == b.nElements_ &&
+    same(sa,sb,14) && same(a.shellCorrection_,b.shellCorrection_,3) &&
+    same(a.nbOfAtomsPerVolume_,b.nbOfAtomsPerVolume_,nelem) && same(a.tau0_,b.tau0_,nelem) &&
+    same(a.alow_,b.alow_,nelem) && same(a.blow_,b.blow_,nelem) && same(a.clow_,b.clow_,nelem) &&
+    same(a.elementZ_,b.elementZ_,nelem);
+}
+
+int main(int argc, char **argv) {
+  string genfile;
+  static struct option long_options[] = {
+    {"generate",     required_argument, 0, 'g'  },
+    {NULL, 0,0,0}
+  };
+  int opt;
+  int long_index =0;
+  while ((opt = getopt_long_only(argc, argv,"",
+	  long_options, &long_index )) != -1) {
+    switch (opt) {
+      case 'g' : genfile = string(optarg);
+		 break;
+      default: print_usage();
+	       exit(EXIT_FAILURE);
+    }
+  }
+  // generation only
+  if(!genfile.empty()){
+    ofstream gen(genfile);
+    size_t nmat = MatCompiledDB::generate(gen);
+    cout << "Wrote " << nmat << " materials to " << genfile << endl;
+    return 0;
+  }
+  vector<string> matnames;
+  for(size_t imat=0;imat<MatCompiledDB::nMaterials();imat++) matnames.push_back(MatCompiledDB::material(imat).name_);
+  // time the initialization and lookup of all materials, first from the compiled database, then from the text database
+  auto start = std::chrono::high_resolution_clock::now();
+  MatDBInfo compiled;
+  vector<DetMaterial const*> cmats;
+  for(auto const& matname : matnames) cmats.push_back(compiled.findDetMaterial(matname));
+  auto mid = std::chrono::high_resolution_clock::now();
+  MatDBInfo text(false);
+  vector<DetMaterial const*> tmats;
+  for(auto const& matname : matnames) tmats.push_back(text.findDetMaterial(matname));
+  auto stop = std::chrono::high_resolution_clock::now();
+  cout << "Initialized " << matnames.size() << " materials in " << std::chrono::duration_cast<std::chrono::microseconds>(mid-start).count()
+    << " us from the compiled database, " << std::chrono::duration_cast<std::chrono::microseconds>(stop-mid).count()
+    << " us from the text database" << endl;
+  int status(0);
+  // every text database material must be in the compiled database with identical properties
+  auto factory = RecoMatFactory::getInstance();
+  size_t ntext(0);
+  for(auto const& mat : *factory->materialDictionary()){
+    MtrPropObj const* mtrprop = factory->GetMtrProperties(*mat.first);
+    if(mtrprop == 0)continue;
+    ntext++;
+    MtrPropData const* cprop = MatCompiledDB::find(*mat.first);
+    if(cprop == 0 || !sameProps(*cprop,MtrPropData::fromMtrProp(*mtrprop))){
+      cout << "Material " << *mat.first << (cprop == 0 ? " missing from" : " differs in") << " the compiled database" << endl;
+      status = -1;
+    }
+  }
+  if(ntext != MatCompiledDB::nMaterials()){
+    cout << "Text database has " << ntext << " materials, compiled database " << MatCompiledDB::nMaterials() << endl;
+    status = -1;
+  }
+  if(MatCompiledDB::find("not-a-material") != 0 || compiled.findDetMaterial("not-a-material") != 0) status = -1;
+  // the materials must behave identically
+  vector<double> masses = {0.511,105.66,938.27};
+  for(size_t imat=0;imat<cmats.size();imat++){
+    if(cmats[imat] == 0 || tmats[imat] == 0){
+      cout << "Material " << matnames[imat] << " not found" << endl;
+      status = -1;
+      continue;
+    }
+    for(auto mass : masses){
+      for(double mom = 10.0; mom < 1000.0; mom *= 1.7){
+	if(cmats[imat]->dEdx(mom,cmats[imat]->elossType(),mass) != tmats[imat]->dEdx(mom,tmats[imat]->elossType(),mass) ||
+	    cmats[imat]->energyLossRMS(mom,1.0,mass) != tmats[imat]->energyLossRMS(mom,1.0,mass) ||
+	    cmats[imat]->scatterAngleRMS(mom,1.0,mass) != tmats[imat]->scatterAngleRMS(mom,1.0,mass)){
+	  cout << "Material " << matnames[imat] << " differs for mass " << mass << " momentum " << mom << endl;
+	  status = -1;
+	}
+      }
+    }
+  }
+  if(status != 0)
+    cout << "The compiled database is out of date: regenerate it with 'MatCompiledDB --generate MatEnv/MatCompiledDBData.cc'" << endl;
+  return status;
+}
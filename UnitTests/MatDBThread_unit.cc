@@ -0,0 +1,87 @@
+//
+// test concurrent use of a frozen MatDBInfo: worker threads look up materials by name and by ID, and compute energy
+// loss and scattering, which must agree exactly with the sequential values
+//
+#include "MatEnv/MatDBInfo.hh"
+#include "MatEnv/DetMaterial.hh"
+#include "MatEnv/MatCompiledDB.hh"
+
+#include <iostream>
+#include <stdio.h>
+#include <getopt.h>
+#include <thread>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace MatEnv;
+using namespace std;
+
+void print_usage() {
+  printf("Usage: MatDBThread --nthreads i --nloop i\n");
+}
+
+int main(int argc, char **argv) {
+  unsigned nthreads(8), nloop(200);
+  static struct option long_options[] = {
+    {"nthreads",     required_argument, 0, 't'  },
+    {"nloop",     required_argument, 0, 'l'  },
+    {NULL, 0,0,0}
+  };
+  int opt;
+  int long_index =0;
+  while ((opt = getopt_long_only(argc, argv,"",
+	  long_options, &long_index )) != -1) {
+    switch (opt) {
+      case 't' : nthreads = atoi(optarg);
+		 break;
+      case 'l' : nloop = atoi(optarg);
+		 break;
+      default: print_usage();
+	       exit(EXIT_FAILURE);
+    }
+  }
+  vector<string> matnames;
+  for(size_t imat=0;imat<MatCompiledDB::nMaterials();imat++) matnames.push_back(MatCompiledDB::material(imat).name_);
+  int status(0);
+  MatDBInfo matdb;
+  matdb.tabulate({0.511,105.66});
+  if(!matdb.preload(matnames) || matdb.nMaterials() != matnames.size()){
+    cout << "Preload failed" << endl;
+    status = -1;
+  }
+  matdb.freeze();
+  // sequential reference values
+  auto matvals = [&matdb](DetMaterial const* dmat, double mom) {
+    return dmat->dEdx(mom,dmat->elossType(),0.511) + dmat->energyLossRMS(mom,1.0,105.66) + dmat->scatterAngleRMS(mom,1.0,938.27); };
+  vector<double> refvals;
+  for(auto const& matname : matnames) refvals.push_back(matvals(matdb.findDetMaterial(matname),100.0));
+  // concurrent lookups
+  atomic<unsigned> nerr(0);
+  vector<thread> threads;
+  for(unsigned ithread=0;ithread<nthreads;ithread++){
+    threads.emplace_back([&,ithread](){
+	for(unsigned iloop=0;iloop<nloop;iloop++){
+	  for(size_t imat=0;imat<matnames.size();imat++){
+	    size_t jmat = (imat + ithread)%matnames.size();
+	    auto dmat = matdb.findDetMaterial(matnames[jmat]);
+	    size_t matid = matdb.materialID(matnames[jmat]);
+	    if(dmat == 0 || matid == MatDBInfo::noMaterial || matdb.material(matid) != dmat || matvals(dmat,100.0) != refvals[jmat]) nerr++;
+	  }
+	}
+      });
+  }
+  for(auto& thread : threads) thread.join();
+  cout << nthreads << " threads made " << nthreads*nloop*matnames.size() << " lookups of " << matdb.nMaterials()
+    << " materials with " << nerr << " errors" << endl;
+  if(nerr > 0) status = -1;
+  // a frozen database can't load or change materials
+  if(matdb.findDetMaterial("not-a-material") != 0 || matdb.nMaterials() != matnames.size()) status = -1;
+  try {
+    matdb.tabulate({139.57});
+    cout << "Frozen database was tabulated" << endl;
+    status = -1;
+  } catch (std::logic_error const&) {}
+  return status;
+}
@@ -104,7 +104,7 @@ int PKTrajTest(int argc, char **argv) {
   // append pieces
   for(int istep=0;istep < nsteps; istep++){
 // use derivatives of last piece to define new piece
-    KTRAJ const& back = ptraj.pieces().back();
+    KTRAJ back = ptraj.pieces().back(); // copy, as appending can invalidate references to the pieces
     double tcomp = back.range().high();
     DVEC pder = back.momDeriv(tcomp,tdir);
     // create modified helix
@@ -137,7 +137,7 @@ int PKTrajTest(int argc, char **argv) {
   }
   // prepend pieces
   for(int istep=0;istep < nsteps; istep++){
-    KTRAJ const& front = ptraj.pieces().front();
+    KTRAJ front = ptraj.pieces().front();
     double tcomp = front.range().low();
     DVEC pder = front.momDeriv(tcomp,tdir);
     // create modified helix
@@ -171,6 +171,16 @@ int PKTrajTest(int argc, char **argv) {
   ptraj.gaps(largest, igap, average);
   cout << "Final piece traj with " << ptraj.pieces().size() << " pieces and largest gap = "
   << largest << " average gap = " << average << endl;
+  // test the piece lookup, with and without a hint
+  size_t hint(0);
+  for(size_t ipiece=0;ipiece < ptraj.pieces().size(); ipiece++){
+    double tmid = ptraj.pieces()[ipiece].range().mid();
+    if(ptraj.nearestIndex(tmid) != ipiece || ptraj.nearestIndex(tmid,hint) != ipiece){
+      cout << "Piece lookup failed for piece " << ipiece << endl;
+      return -2;
+    }
+    hint = ipiece;
+  }
 
 // draw each piece of the piecetraj
   char fname[100];
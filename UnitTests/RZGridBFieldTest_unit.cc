@@ -0,0 +1,172 @@
+//
+// test RZGridBField against an analytic axisymmetric field, and benchmark it against a 3D GridBField of the same resolution
+//
+#include "KinKal/GridBField.hh"
+#include "KinKal/LHelix.hh"
+#include "KinKal/Vectors.hh"
+
+#include <iostream>
+#include <fstream>
+#include <stdio.h>
+#include <getopt.h>
+#include <chrono>
+#include <random>
+#include <cmath>
+#include <string>
+#include <vector>
+
+using namespace KinKal;
+using namespace std;
+
+void print_usage() {
+  printf("Usage: RZGridBFieldTest --convert s --output s --nr i --nz i --dBdz2 f --interp i --nbench i\n");
+}
+
+int main(int argc, char **argv) {
+  string asciifile, binaryfile("RZGridBFieldTest.bin");
+  unsigned nr(26), nz(61);
+  double dbdz2(4.0e-8); // analytic field curvature (Tesla/mm^2)
+  double rmax(800.0), zmax(1500.0); // grid range (mm)
+  int interp(GridBField::tricubic);
+  unsigned nbench(1000000);
+
+  static struct option long_options[] = {
+    {"convert",     required_argument, 0, 'c'  },
+    {"output",     required_argument, 0, 'o'  },
+    {"nr",     required_argument, 0, 'r'  },
+    {"nz",     required_argument, 0, 'z'  },
+    {"dBdz2",     required_argument, 0, 'd'  },
+    {"interp",     required_argument, 0, 'i'  },
+    {"nbench",     required_argument, 0, 'b'  },
+    {NULL, 0,0,0}
+  };
+  int opt;
+  int long_index =0;
+  while ((opt = getopt_long_only(argc, argv,"",
+	  long_options, &long_index )) != -1) {
+    switch (opt) {
+      case 'c' : asciifile = string(optarg);
+		 break;
+      case 'o' : binaryfile = string(optarg);
+		 break;
+      case 'r' : nr = atoi(optarg);
+		 break;
+      case 'z' : nz = atoi(optarg);
+		 break;
+      case 'd' : dbdz2 = atof(optarg);
+		 break;
+      case 'i' : interp = atoi(optarg);
+		 break;
+      case 'b' : nbench = atoi(optarg);
+		 break;
+      default: print_usage();
+	       exit(EXIT_FAILURE);
+    }
+  }
+  // conversion only
+  if(!asciifile.empty()){
+    size_t ngrid = RZGridBField::convert(asciifile,binaryfile);
+    cout << "Converted " << ngrid << " grid points from " << asciifile << " to " << binaryfile << endl;
+    return 0;
+  }
+  // analytic solenoid-like test field: this satisfies Maxwell's equations
+  auto bfield = [dbdz2](Vec3 const& pos) {
+    return Vec3(-dbdz2*pos.X()*pos.Z(), -dbdz2*pos.Y()*pos.Z(), 1.0 + dbdz2*(pos.Z()*pos.Z() - 0.5*pos.Perp2())); };
+  auto bgrad = [dbdz2](Vec3 const& pos) {
+    BField::Grad grad;
+    grad(0,0) = grad(1,1) = -dbdz2*pos.Z();
+    grad(0,2) = grad(2,0) = -dbdz2*pos.X();
+    grad(1,2) = grad(2,1) = -dbdz2*pos.Y();
+    grad(2,2) = 2.0*dbdz2*pos.Z();
+    return grad;
+  };
+  // write (r,z) and 3D dumps with the same grid spacing
+  double dr = rmax/(nr-1), dz = 2*zmax/(nz-1);
+  string rzascii("RZGridBFieldTest.txt"), xyzascii("RZGridBFieldTest_3D.txt"), xyzbinary("RZGridBFieldTest_3D.bin");
+  {
+    ofstream ascii(rzascii);
+    ascii.precision(10);
+    ascii << "# r z Br Bz" << endl;
+    for(unsigned ir=0;ir<nr;ir++){
+      for(unsigned iz=0;iz<nz;iz++){
+	Vec3 pos(ir*dr, 0.0, -zmax + iz*dz);
+	Vec3 bvec = bfield(pos);
+	ascii << pos.X() << " " << pos.Z() << " " << bvec.X() << " " << bvec.Z() << endl;
+      }
+    }
+    ofstream ascii3(xyzascii);
+    ascii3.precision(10);
+    ascii3 << "# x y z Bx By Bz" << endl;
+    for(unsigned ix=0;ix<2*nr-1;ix++){
+      for(unsigned iy=0;iy<2*nr-1;iy++){
+	for(unsigned iz=0;iz<nz;iz++){
+	  Vec3 pos(-rmax + ix*dr, -rmax + iy*dr, -zmax + iz*dz);
+	  Vec3 bvec = bfield(pos);
+	  ascii3 << pos.X() << " " << pos.Y() << " " << pos.Z() << " " << bvec.X() << " " << bvec.Y() << " " << bvec.Z() << endl;
+	}
+      }
+    }
+  }
+  RZGridBField::convert(rzascii,binaryfile);
+  GridBField::convert(xyzascii,xyzbinary);
+  auto itype = static_cast<GridBField::Interp>(interp);
+  RZGridBField rzfield(binaryfile,itype);
+  GridBField xyzfield(xyzbinary,itype);
+  int status(0);
+  // compare with the analytic field inside the grid, away from the edges
+  std::mt19937 rng(12345);
+  std::uniform_real_distribution<double> rgen(0.0,rmax-2*dr), phigen(-M_PI,M_PI), zgen(-zmax+dz,zmax-dz);
+  std::vector<Vec3> points;
+  for(unsigned ipt=0;ipt<10000;ipt++){
+    double rad = rgen(rng), phi = phigen(rng);
+    points.push_back(Vec3(rad*cos(phi),rad*sin(phi),zgen(rng)));
+  }
+  points.push_back(Vec3(0.0,0.0,100.0)); // on axis
+  // with tricubic interpolation, a quadratic field is reproduced up to the float precision of the map.  Linear
+  // interpolation misses the curvature terms
+  double btol = itype == GridBField::tricubic ? 1.0e-6 : 1.01*dbdz2*(dz*dz+dr*dr)/4.0 + 1.0e-6;
+  double gtol = itype == GridBField::tricubic ? 1.0e-8 : 1.01*dbdz2*(dz+dr) + 1.0e-8;
+  BField const* fields[2] = {&rzfield, &xyzfield};
+  const char* fieldnames[2] = {"RZGridBField", "GridBField"};
+  size_t fieldmem[2] = {2*sizeof(float)*rzfield.nPoints(), 3*sizeof(float)*xyzfield.nPoints()};
+  for(unsigned ifield=0;ifield<2;ifield++){
+    double maxdb(0.0), maxdg(0.0);
+    for(auto const& pos : points){
+      maxdb = std::max(maxdb,(fields[ifield]->fieldVect(pos)-bfield(pos)).R());
+      auto dgrad = fields[ifield]->fieldGrad(pos) - bgrad(pos);
+      for(unsigned irow=0;irow<3;irow++)
+	for(unsigned icol=0;icol<3;icol++)
+	  maxdg = std::max(maxdg,fabs(dgrad(irow,icol)));
+    }
+    // benchmark evaluation along random helical paths, as in a fit
+    auto start = std::chrono::high_resolution_clock::now();
+    Vec3 bsum;
+    for(unsigned ibench=0;ibench<nbench;ibench++){
+      auto const& pos = points[(ibench/100)%points.size()];
+      double phi = 0.01*(ibench%100);
+      Vec3 hpos(pos.X()*cos(phi)-pos.Y()*sin(phi), pos.X()*sin(phi)+pos.Y()*cos(phi), pos.Z() + 5.0*(ibench%100));
+      bsum += fields[ifield]->fieldVect(hpos);
+      if(ibench%10 == 0) bsum += fields[ifield]->fieldDeriv(hpos,Vec3(1.0,1.0,1.0));
+    }
+    auto stop = std::chrono::high_resolution_clock::now();
+    cout << fieldnames[ifield] << " " << fieldmem[ifield] << " bytes, max field difference " << maxdb << " max gradient difference " << maxdg
+      << ", " << std::chrono::duration_cast<std::chrono::nanoseconds>(stop-start).count()/double(std::max(nbench,1u)) << " ns/evaluation (" << bsum.R() << ")" << endl;
+    if(maxdb > btol || maxdg > gtol){
+      cout << fieldnames[ifield] << " interpolation out of tolerance" << endl;
+      status = -1;
+    }
+  }
+  // the map must work as-is in the trajectory domain calculation
+  Vec4 hpos(100.0,-50.0,-1000.0,0.0);
+  Mom4 hmom(30.0,80.0,40.0,0.511);
+  LHelix lhelix(hpos,hmom,-1,rzfield.fieldVect(hpos.Vect()),TRange(0.0,50.0));
+  TRange rzrange(0.0,50.0), xyzrange(0.0,50.0);
+  lhelix.rangeInTolerance(rzrange,rzfield,0.01);
+  lhelix.rangeInTolerance(xyzrange,xyzfield,0.01);
+  cout << "Helix range in tolerance RZ " << rzrange.range() << " 3D " << xyzrange.range() << endl;
+  if(fabs(rzrange.range()-xyzrange.range()) > 0.1*xyzrange.range()){
+    cout << "Inconsistent range in tolerance" << endl;
+    status = -1;
+  }
+  return status;
+}
@@ -0,0 +1,91 @@
+//
+// test StrawMat: compare the tabulated material crossings with the exact gas and wall paths, and benchmark both
+//
+#include "KinKal/StrawMat.hh"
+#include "MatEnv/MatDBInfo.hh"
+
+#include <iostream>
+#include <stdio.h>
+#include <getopt.h>
+#include <chrono>
+#include <random>
+#include <cmath>
+#include <vector>
+
+using namespace KinKal;
+using namespace std;
+
+void print_usage() {
+  printf("Usage: StrawMat --rstraw f --thick f --rwire f --precision f --ntest i\n");
+}
+
+int main(int argc, char **argv) {
+  double rstraw(2.5), thick(0.015), rwire(0.025);
+  double precision(1.0e-4);
+  unsigned ntest(200000);
+  static struct option long_options[] = {
+    {"rstraw",     required_argument, 0, 'r'  },
+    {"thick",     required_argument, 0, 't'  },
+    {"rwire",     required_argument, 0, 'w'  },
+    {"precision",     required_argument, 0, 'p'  },
+    {"ntest",     required_argument, 0, 'n'  },
+    {NULL, 0,0,0}
+  };
+  int opt;
+  int long_index =0;
+  while ((opt = getopt_long_only(argc, argv,"",
+	  long_options, &long_index )) != -1) {
+    switch (opt) {
+      case 'r' : rstraw = atof(optarg);
+		 break;
+      case 't' : thick = atof(optarg);
+		 break;
+      case 'w' : rwire = atof(optarg);
+		 break;
+      case 'p' : precision = atof(optarg);
+		 break;
+      case 'n' : ntest = atoi(optarg);
+		 break;
+      default: print_usage();
+	       exit(EXIT_FAILURE);
+    }
+  }
+  MatEnv::MatDBInfo matdbinfo;
+  StrawMat smat(matdbinfo,rstraw,thick,rwire);
+  // random crossings, covering DOCA outside the straw and large DOCA errors
+  std::mt19937 rng(12345);
+  std::uniform_real_distribution<double> docagen(-1.1*rstraw,1.1*rstraw), ddocagen(0.0,1.5*rstraw), adotgen(-0.95,0.95);
+  struct Xing { double doca_, ddoca_, adot_; };
+  vector<Xing> xings(ntest);
+  for(auto& xing : xings) xing = Xing{docagen(rng),ddocagen(rng),adotgen(rng)};
+  double maxdg(0.0), maxdw(0.0);
+  MatXingCol mxings;
+  for(auto const& xing : xings){
+    smat.findXings(xing.doca_,xing.ddoca_,xing.adot_,mxings);
+    if(mxings.size() != 2 || &mxings[0].dmat_ != &smat.wallMaterial() || &mxings[1].dmat_ != &smat.gasMaterial()){
+      cout << "Unexpected material crossings" << endl;
+      return -1;
+    }
+    maxdw = std::max(maxdw,fabs(mxings[0].plen_/smat.wallPath(xing.doca_,xing.ddoca_,xing.adot_)-1.0));
+    maxdg = std::max(maxdg,fabs(mxings[1].plen_/smat.gasPath(xing.doca_,xing.ddoca_,xing.adot_)-1.0));
+  }
+  // benchmark
+  auto start = std::chrono::high_resolution_clock::now();
+  double psum(0.0);
+  for(auto const& xing : xings) psum += smat.wallPath(xing.doca_,xing.ddoca_,xing.adot_) + smat.gasPath(xing.doca_,xing.ddoca_,xing.adot_);
+  auto mid = std::chrono::high_resolution_clock::now();
+  for(auto const& xing : xings){
+    smat.findXings(xing.doca_,xing.ddoca_,xing.adot_,mxings);
+    psum += mxings[0].plen_ + mxings[1].plen_;
+  }
+  auto stop = std::chrono::high_resolution_clock::now();
+  double nxing = std::max(ntest,1u);
+  cout << "Max relative path difference wall " << maxdw << " gas " << maxdg << "; exact "
+    << std::chrono::duration_cast<std::chrono::nanoseconds>(mid-start).count()/nxing << " ns/crossing, tabulated "
+    << std::chrono::duration_cast<std::chrono::nanoseconds>(stop-mid).count()/nxing << " ns/crossing (" << psum << ")" << endl;
+  if(maxdw > precision || maxdg > precision){
+    cout << "Tabulated paths out of tolerance" << endl;
+    return -1;
+  }
+  return 0;
+}
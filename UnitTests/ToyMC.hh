@@ -43,7 +43,9 @@ namespace KKTest {
 	momvar_(1.0), ttsig_(0.5), twsig_(10.0), shmax_(80.0), clen_(200.0), cprop_(0.8*CLHEP::c_light),
 	osig_(10.0), ctmin_(0.5), ctmax_(0.8), tbuff_(0.1), tol_(0.01),
 	smat_(matdb_,rstraw_, wthick_,rwire_),
-	d2t_(sdrift_,sigt_*sigt_,rstraw_) {}
+	d2t_(sdrift_,sigt_*sigt_,rstraw_) {
+	  // the straw materials are now loaded; freeze so that they can be shared by concurrent fits
+	  matdb_.freeze(); }
 
       // generate a straw at the given time.  direction and drift distance are random
       TLine generateStraw(PKTRAJ const& traj, double htime);